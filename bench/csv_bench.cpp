@@ -0,0 +1,310 @@
+//
+// Created by Andres Jaimes on 05/07/25.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../src/basic_csv_parser.h"
+#include "../src/csv_json_writer.h"
+#include "../src/csv_parser.h"
+#include "../src/csv_reader.h"
+#include "../src/csv_scanner.h"
+#include "../src/json.hpp"
+#include "../src/utils.h"
+
+extern "C" size_t sv_parse_csv_line(const char* line, char separator);
+extern "C" size_t sv_parse_csv_line_w(const wchar_t* line, wchar_t separator);
+extern "C" const wchar_t* sv_csv_field_w(size_t index);
+
+/*
+ * Csv throughput benchmarks over generated datasets. Every dataset is built from a fixed
+ * seed, so runs are comparable across builds. Results are printed as one json object per
+ * line, on stdout.
+ *
+ * Usage: sevilla_bench [--rows N] [--repeat N] [--filter text]
+ */
+
+namespace {
+
+    struct dataset {
+        std::string name;
+        std::string data;
+        std::vector<std::string> lines;
+        std::vector<std::wstring> wide_lines;
+        size_t rows = 0;
+    };
+
+    struct dataset_spec {
+        std::string name;
+        size_t rows;
+        size_t columns;
+        size_t field_length;
+        int quoted;
+        bool unicode;
+    };
+
+    struct options {
+        size_t rows = 100000;
+        int repeat = 5;
+        std::string filter;
+    };
+
+    std::string random_text(std::mt19937& random, const size_t length, const bool unicode) {
+        static const char* const symbols[] = {"á", "ñ", "ü", "ß", "€", "中", "日", "ж"};
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::uniform_int_distribution<int> pick(0, 7);
+        std::uniform_int_distribution<int> coin(0, 3);
+        std::string text;
+
+        while (text.size() < length) {
+            if (unicode && coin(random) == 0) {
+                text += symbols[pick(random)];
+            } else {
+                text += static_cast<char>(letter(random));
+            }
+        }
+        return text;
+    }
+
+    /**
+     * `quoted` is the share of fields, out of 100, that are quoted with separators and
+     * escaped quotes inside.
+     */
+    dataset make_dataset(const std::string& name, const size_t rows, const size_t columns,
+                         const size_t field_length, const int quoted, const bool unicode) {
+        std::mt19937 random(20250705);
+        std::uniform_int_distribution<size_t> length(1, field_length * 2);
+        std::uniform_int_distribution<int> percent(0, 99);
+        dataset set;
+        set.name = name;
+        set.rows = rows;
+
+        for (size_t r = 0; r < rows; r++) {
+            std::string line;
+            for (size_t c = 0; c < columns; c++) {
+                if (c > 0) {
+                    line += ',';
+                }
+                const std::string text = random_text(random, length(random), unicode);
+                if (percent(random) < quoted) {
+                    // cut on a utf-8 character boundary
+                    size_t half = text.size() / 2;
+                    while (half > 0 && (static_cast<unsigned char>(text[half]) & 0xC0) == 0x80) {
+                        half--;
+                    }
+                    line += "\"" + text + ", \"\"" + text.substr(0, half) + "\"\"\"";
+                } else {
+                    line += text;
+                }
+            }
+            set.data += line;
+            set.data += '\n';
+            set.lines.push_back(std::move(line));
+        }
+
+        for (const std::string& line : set.lines) {
+            sevilla::utf8_to_wide(line, set.wide_lines.emplace_back());
+        }
+
+        return set;
+    }
+
+    /**
+     * Runs `body` `repeat` times and keeps the fastest run.
+     */
+    double best_time(const int repeat, const std::function<size_t()>& body) {
+        double best = 1e100;
+        size_t check = 0;
+
+        for (int i = 0; i < repeat; i++) {
+            const auto start = std::chrono::steady_clock::now();
+            check += body();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+
+        // keeps the work from being optimized away
+        if (check == 0) {
+            std::fprintf(stderr, "benchmark produced no fields\n");
+            std::exit(1);
+        }
+        return best;
+    }
+
+    void report(const std::string& benchmark, const dataset& set, const std::string& engine, const double seconds) {
+        nlohmann::json j;
+        j["benchmark"] = benchmark;
+        j["dataset"] = set.name;
+        j["engine"] = engine;
+        j["bytes"] = set.data.size();
+        j["rows"] = set.rows;
+        j["seconds"] = seconds;
+        j["mb_per_s"] = static_cast<double>(set.data.size()) / seconds / 1e6;
+        j["rows_per_s"] = static_cast<double>(set.rows) / seconds;
+        std::printf("%s\n", j.dump().c_str());
+        std::fflush(stdout);
+    }
+
+    void run(const dataset& set, const options& opts) {
+        const std::string best = sevilla::csv_scanner::engine_name(sevilla::csv_scanner::best_engine());
+
+        for (const auto engine : {sevilla::csv_scanner::engine::scalar,
+                                  sevilla::csv_scanner::engine::sse2,
+                                  sevilla::csv_scanner::engine::avx2}) {
+            if (!sevilla::csv_scanner::supported(engine)) {
+                continue;
+            }
+            const std::string name = sevilla::csv_scanner::engine_name(engine);
+
+            sevilla::csv_scanner scanner(engine);
+            report("scan", set, name, best_time(opts.repeat, [&] {
+                bool in_quotes = false;
+                return scanner.scan(set.data.data(), set.data.size(), ',', '"', false, in_quotes);
+            }));
+
+            sevilla::csv_parser parser(engine);
+            report("parse_line_view", set, name, best_time(opts.repeat, [&] {
+                size_t fields = 0;
+                for (const std::string& line : set.lines) {
+                    fields += parser.parse_line_view(line, ',');
+                }
+                return fields;
+            }));
+        }
+
+        sevilla::csv_parser parser;
+        report("parse_line", set, best, best_time(opts.repeat, [&] {
+            size_t fields = 0;
+            for (const std::string& line : set.lines) {
+                fields += parser.parse_line(line, ',');
+            }
+            return fields;
+        }));
+
+        report("parse_record", set, best, best_time(opts.repeat, [&] {
+            size_t fields = 0;
+            for (size_t position = 0; position < set.data.size();) {
+                position += parser.parse_record(std::string_view(set.data).substr(position), ',');
+                fields += parser.size();
+            }
+            return fields;
+        }));
+
+        // the best engine, and the 8 bytes at a time fallback, unless that is the best already
+        std::vector<sevilla::csv_scanner::engine> comma_engines = {sevilla::csv_scanner::best_engine()};
+        if (comma_engines[0] != sevilla::csv_scanner::engine::scalar) {
+            comma_engines.push_back(sevilla::csv_scanner::engine::scalar);
+        }
+
+        for (const auto engine : comma_engines) {
+            sevilla::comma_csv_parser comma(engine);
+            const std::string name = engine == sevilla::csv_scanner::engine::scalar
+                                     ? "swar" : sevilla::csv_scanner::engine_name(engine);
+            report("comma_csv_parser", set, name, best_time(opts.repeat, [&] {
+                size_t fields = 0;
+                for (size_t position = 0; position < set.data.size();) {
+                    position += comma.parse_record(std::string_view(set.data).substr(position));
+                    fields += comma.size();
+                }
+                return fields;
+            }));
+        }
+
+        report("sv_parse_csv_line", set, best, best_time(opts.repeat, [&] {
+            size_t fields = 0;
+            for (const std::string& line : set.lines) {
+                fields += sv_parse_csv_line(line.c_str(), ',');
+            }
+            return fields;
+        }));
+
+        report("sv_parse_csv_line_w", set, best, best_time(opts.repeat, [&] {
+            size_t fields = 0;
+            for (const std::wstring& line : set.wide_lines) {
+                fields += sv_parse_csv_line_w(line.c_str(), L',');
+            }
+            return fields;
+        }));
+
+        report("sv_csv_field_w", set, best, best_time(opts.repeat, [&] {
+            size_t chars = 0;
+            for (const std::wstring& line : set.wide_lines) {
+                const size_t count = sv_parse_csv_line_w(line.c_str(), L',');
+                for (size_t i = 0; i < count; i++) {
+                    chars += std::wcslen(sv_csv_field_w(i));
+                }
+            }
+            return chars;
+        }));
+
+        report("csv_reader", set, best, best_time(opts.repeat, [&] {
+            sevilla::csv_reader reader;
+            reader.open(set.data.data(), set.data.size(), ',');
+            size_t fields = 0;
+            while (reader.next()) {
+                fields += reader.size();
+            }
+            return fields;
+        }));
+
+        report("csv_json_writer", set, best, best_time(opts.repeat, [&] {
+            sevilla::csv_reader reader;
+            reader.open(set.data.data(), set.data.size(), ',');
+            sevilla::csv_json_writer writer;
+            size_t bytes = 0;
+            while (reader.next()) {
+                writer.write_row(reader.record());
+                // flushed like a file writer would, so the buffer stays small
+                if (writer.data().size() >= 64 * 1024) {
+                    bytes += writer.data().size();
+                    writer.clear();
+                }
+            }
+            return bytes + writer.data().size();
+        }));
+    }
+
+    options parse_options(const int argc, char** argv) {
+        options opts;
+        for (int i = 1; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "--rows") == 0) {
+                opts.rows = std::strtoul(argv[i + 1], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--repeat") == 0) {
+                opts.repeat = std::max(1, std::atoi(argv[i + 1]));
+            } else if (std::strcmp(argv[i], "--filter") == 0) {
+                opts.filter = argv[i + 1];
+            }
+        }
+        return opts;
+    }
+
+}
+
+int main(const int argc, char** argv) {
+    const options opts = parse_options(argc, argv);
+
+    // name, rows, columns, average field length, share of quoted fields, unicode
+    const std::vector<dataset_spec> specs = {
+        {"narrow", opts.rows, 4, 8, 0, false},
+        {"wide", opts.rows / 20, 200, 8, 0, false},
+        {"quoted", opts.rows, 8, 12, 60, false},
+        {"unicode", opts.rows, 8, 12, 10, true},
+        {"long_fields", opts.rows / 20, 4, 1000, 10, false},
+    };
+
+    for (const dataset_spec& spec : specs) {
+        if (opts.filter.empty() || spec.name.find(opts.filter) != std::string::npos) {
+            run(make_dataset(spec.name, spec.rows, spec.columns, spec.field_length, spec.quoted, spec.unicode), opts);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+//
+// Created by Andres Jaimes on 06/09/25.
+//
+
+#include "basic_csv_parser.h"
+
+namespace sevilla {
+
+    template class basic_csv_parser<','>;
+    template class basic_csv_parser<'\t'>;
+    template class basic_csv_parser<';'>;
+    template class basic_csv_parser<'|'>;
+
+}
@@ -0,0 +1,314 @@
+//
+// Created by Andres Jaimes on 06/09/25.
+//
+
+#ifndef BASIC_CSV_PARSER_H
+#define BASIC_CSV_PARSER_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "csv_arena.h"
+#include "csv_scanner.h"
+
+namespace sevilla {
+
+    /**
+     * A csv parser whose dialect is fixed at compile time, so every comparison against the
+     * separator and the quote folds into a constant, and the projection and filter checks
+     * of `csv_parser` are left out. Fields are found by the vector engines of `csv_scanner`
+     * when the cpu has them, and 8 bytes at a time with plain 64-bit arithmetic otherwise.
+     * With `Trim`, spaces and tabs around fields are dropped, outside quotes.
+     *
+     * Fields are parsed like `csv_parser` does: quotes may appear anywhere in a field, and
+     * doubled quotes inside them are unescaped. The common dialects are instantiated in the
+     * library; see the aliases below.
+     */
+    template <char Sep, char Quote = '"', bool Trim = false>
+    class basic_csv_parser {
+
+    private:
+        csv_scanner scanner;
+        std::vector<std::string_view> fields;
+
+        /**
+         * Backing storage for unescaped fields, reset before every record.
+         */
+        csv_arena arena;
+
+        bool complete = false;
+
+        static constexpr uint64_t ones = 0x0101010101010101ULL;
+        static constexpr uint64_t highs = 0x8080808080808080ULL;
+
+        static constexpr uint64_t broadcast(const char c) {
+            return ones * static_cast<unsigned char>(c);
+        }
+
+        /**
+         * Sets the high bit of a byte of `word` that equals a byte of `pattern`, at least for
+         * the first such byte.
+         */
+        static uint64_t matches(const uint64_t word, const uint64_t pattern) {
+            const uint64_t x = word ^ pattern;
+            return (x - ones) & ~x & highs;
+        }
+
+        template <bool LineBreaks>
+        static bool structural(const char c) {
+            return c == Sep || c == Quote || (LineBreaks && c == '\n');
+        }
+
+        /**
+         * Returns the position of the first separator or quote, or line feed with `LineBreaks`,
+         * at or after `from`. Returns `size` when there is none.
+         */
+        template <bool LineBreaks>
+        static size_t find(const char* data, size_t from, const size_t size) {
+            for (; from + 8 <= size; from += 8) {
+                uint64_t word;
+                std::memcpy(&word, data + from, 8);
+                uint64_t hits = matches(word, broadcast(Sep)) | matches(word, broadcast(Quote));
+                if (LineBreaks) {
+                    hits |= matches(word, broadcast('\n'));
+                }
+                if (hits != 0) {
+#if defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                    // the lowest flagged byte is always a real match
+                    return from + __builtin_ctzll(hits) / 8;
+#else
+                    break;
+#endif
+                }
+            }
+            for (; from < size; from++) {
+                if (structural<LineBreaks>(data[from])) {
+                    return from;
+                }
+            }
+            return size;
+        }
+
+        static std::string_view trim(std::string_view raw) {
+            while (!raw.empty() && (raw.front() == ' ' || raw.front() == '\t')) {
+                raw.remove_prefix(1);
+            }
+            while (!raw.empty() && (raw.back() == ' ' || raw.back() == '\t')) {
+                raw.remove_suffix(1);
+            }
+            return raw;
+        }
+
+        std::string_view decode(std::string_view raw, const bool quoted) {
+            if (Trim) {
+                raw = trim(raw);
+            }
+            if (!quoted) {
+                return raw;
+            }
+
+            // a fully quoted field without escapes is just a span without its quotes
+            if (raw.size() >= 2 && raw.front() == Quote && raw.back() == Quote && raw.find(Quote, 1) == raw.size() - 1) {
+                return raw.substr(1, raw.size() - 2);
+            }
+
+            // unescaping never grows a field
+            char* const begin = arena.allocate(raw.size());
+            char* out = begin;
+            bool in_quotes = false;
+
+            for (size_t i = 0; i < raw.size(); i++) {
+                const char c = raw[i];
+                if (c != Quote) {
+                    *out++ = c;
+                } else if (!in_quotes) {
+                    in_quotes = true;
+                } else if (i + 1 < raw.size() && raw[i + 1] == Quote) {
+                    *out++ = Quote;
+                    i++;
+                } else {
+                    in_quotes = false;
+                }
+            }
+
+            return {begin, static_cast<size_t>(out - begin)};
+        }
+
+        template <bool LineBreaks>
+        size_t parse(const std::string_view data) {
+            fields.clear();
+            complete = false;
+
+            arena.reset();
+
+            if (scanner.get_engine() == csv_scanner::engine::scalar) {
+                return parse_words<LineBreaks>(data);
+            }
+            return parse_blocks<LineBreaks>(data);
+        }
+
+        /**
+         * Splits fields at the offsets found by the scanner, like `csv_parser` does.
+         */
+        template <bool LineBreaks>
+        size_t parse_blocks(const std::string_view data) {
+            const char* bytes = data.data();
+            bool in_quotes = false;
+            size_t count = scanner.scan(bytes, data.size(), Sep, Quote, LineBreaks, in_quotes);
+            const size_t* offsets = scanner.offsets();
+
+            size_t end = data.size();
+            size_t consumed = data.size();
+            if (LineBreaks && count > 0 && bytes[offsets[count - 1]] == '\n' && !in_quotes) {
+                end = offsets[count - 1];
+                consumed = end + 1;
+                complete = true;
+                count--;
+            }
+            if (LineBreaks && !in_quotes && end > 0 && bytes[end - 1] == '\r') {
+                end--;
+            }
+
+            size_t start = 0;
+            bool quoted = false;
+            for (size_t k = 0; k < count && offsets[k] < end; k++) {
+                const size_t i = offsets[k];
+                if (bytes[i] == Quote) {
+                    quoted = true;
+                } else {
+                    fields.push_back(decode(data.substr(start, i - start), quoted));
+                    start = i + 1;
+                    quoted = false;
+                }
+            }
+
+            fields.push_back(decode(data.substr(start, end - start), quoted));
+            return consumed;
+        }
+
+        /**
+         * Walks the data field by field, looking for structural characters 8 bytes at a time.
+         */
+        template <bool LineBreaks>
+        size_t parse_words(const std::string_view data) {
+            const char* bytes = data.data();
+            const size_t size = data.size();
+            size_t start = 0;
+            size_t position = 0;
+            bool quoted = false;
+
+            while (true) {
+                position = find<LineBreaks>(bytes, position, size);
+
+                if (position == size) {
+                    size_t end = size;
+                    if (LineBreaks && end > start && bytes[end - 1] == '\r') {
+                        end--;
+                    }
+                    fields.push_back(decode(data.substr(start, end - start), quoted));
+                    return size;
+                }
+
+                const char c = bytes[position];
+                if (c == Quote) {
+                    // skip to the closing quote; without one, the field runs to the end
+                    quoted = true;
+                    const void* closing = std::memchr(bytes + position + 1, Quote, size - position - 1);
+                    if (closing == nullptr) {
+                        fields.push_back(decode(data.substr(start), quoted));
+                        return size;
+                    }
+                    position = static_cast<const char*>(closing) - bytes + 1;
+                } else if (c == Sep) {
+                    fields.push_back(decode(data.substr(start, position - start), quoted));
+                    start = ++position;
+                    quoted = false;
+                } else {
+                    size_t end = position;
+                    if (end > start && bytes[end - 1] == '\r') {
+                        end--;
+                    }
+                    fields.push_back(decode(data.substr(start, end - start), quoted));
+                    complete = true;
+                    return position + 1;
+                }
+            }
+        }
+
+    public:
+        static constexpr char separator = Sep;
+        static constexpr char quote = Quote;
+
+        basic_csv_parser() = default;
+
+        /**
+         * Uses a specific scanning engine instead of the fastest one available. With the
+         * scalar engine, fields are found 8 bytes at a time.
+         */
+        explicit basic_csv_parser(const csv_scanner::engine engine) : scanner(engine) {}
+
+        /**
+         * Parses a csv line without copying it. Line feeds are part of the fields.
+         * See `csv_parser::parse_line_view`.
+         */
+        size_t parse_line_view(const std::string_view line) {
+            parse<false>(line);
+            return fields.size();
+        }
+
+        /**
+         * Parses the first record in `data`, without copying it, and returns the number of
+         * bytes consumed. See `csv_parser::parse_record`.
+         */
+        size_t parse_record(const std::string_view data) {
+            return parse<true>(data);
+        }
+
+        /**
+         * Returns whether the last record parsed by `parse_record` ended with a line break.
+         */
+        bool terminated() const {
+            return complete;
+        }
+
+        std::string_view view(const size_t index) const {
+            if (index >= fields.size()) {
+                throw std::out_of_range("Index is out of range");
+            }
+            return fields[index];
+        }
+
+        /**
+         * Returns every field of the last parsed line.
+         */
+        const std::vector<std::string_view>& views() const {
+            return fields;
+        }
+
+        size_t size() const {
+            return fields.size();
+        }
+
+        void reset() {
+            fields.clear();
+            complete = false;
+        }
+
+    };
+
+    extern template class basic_csv_parser<','>;
+    extern template class basic_csv_parser<'\t'>;
+    extern template class basic_csv_parser<';'>;
+    extern template class basic_csv_parser<'|'>;
+
+    using comma_csv_parser = basic_csv_parser<','>;
+    using tab_csv_parser = basic_csv_parser<'\t'>;
+    using semicolon_csv_parser = basic_csv_parser<';'>;
+    using pipe_csv_parser = basic_csv_parser<'|'>;
+
+}
+
+#endif //BASIC_CSV_PARSER_H
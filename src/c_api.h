@@ -5,6 +5,8 @@
 #ifndef C_API_H
 #define C_API_H
 
+#include <string>
+
 #ifdef _WIN32
     #define DLL_EXPORT __declspec(dllexport)
 #else
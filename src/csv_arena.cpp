@@ -0,0 +1,85 @@
+//
+// Created by Andres Jaimes on 18/10/25.
+//
+
+#include <algorithm>
+#include <functional>
+#include "csv_arena.h"
+
+namespace sevilla {
+
+    csv_arena::csv_arena(const size_t block_size) : block_size(std::max<size_t>(block_size, 1)) {}
+
+    char* csv_arena::allocate(const size_t size) {
+        allocated += size;
+
+        if (!blocks.empty() && blocks[current].size - used >= size) {
+            char* data = blocks[current].data.get() + used;
+            used += size;
+            return data;
+        }
+
+        // blocks kept after a rewind are used again before new ones are added
+        while (current + 1 < blocks.size()) {
+            current++;
+            used = 0;
+            if (blocks[current].size >= size) {
+                used = size;
+                return blocks[current].data.get();
+            }
+        }
+
+        // blocks double, so a row or batch of any size takes a few of them
+        const size_t grown = blocks.empty() ? block_size : 2 * blocks.back().size;
+        const size_t capacity = std::max(size, grown);
+        blocks.push_back({std::unique_ptr<char[]>(new char[capacity]), capacity});
+        current = blocks.size() - 1;
+        used = size;
+        return blocks.back().data.get();
+    }
+
+    csv_arena::mark csv_arena::position() const {
+        return {current, used, allocated};
+    }
+
+    void csv_arena::rewind(const mark& position) {
+        current = position.block;
+        used = position.used;
+        allocated = position.allocated;
+    }
+
+    void csv_arena::reset() {
+        if (blocks.size() > 1) {
+            const size_t total = capacity();
+            blocks.clear();
+            blocks.push_back({std::unique_ptr<char[]>(new char[total]), total});
+        }
+        current = 0;
+        used = 0;
+        allocated = 0;
+    }
+
+    bool csv_arena::contains(const char* data) const {
+        // std::less gives a total order, even for pointers into unrelated blocks
+        const std::less<const char*> before;
+        for (const block& b : blocks) {
+            if (!before(data, b.data.get()) && before(data, b.data.get() + b.size)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t csv_arena::size() const {
+        return allocated;
+    }
+
+    size_t csv_arena::capacity() const {
+        size_t total = 0;
+        for (const block& b : blocks) {
+            total += b.size;
+        }
+        return total;
+    }
+
+}
@@ -0,0 +1,101 @@
+//
+// Created by Andres Jaimes on 18/10/25.
+//
+
+#ifndef CSV_ARENA_H
+#define CSV_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace sevilla {
+
+    /**
+     * A bump allocator for field bytes. Allocations are carved out of large blocks, which
+     * never move, so spans into them stay valid until the arena is reset, and nothing is
+     * freed one by one. A reset keeps the memory: when a row or batch needed more than one
+     * block, they are merged into one block of their total size, so the next row or batch
+     * of that size fits in it without allocating.
+     */
+    class csv_arena {
+
+    private:
+        struct block {
+            std::unique_ptr<char[]> data;
+            size_t size;
+        };
+
+        std::vector<block> blocks;
+
+        /**
+         * The block being filled, and the bytes used in it.
+         */
+        size_t current = 0;
+        size_t used = 0;
+
+        size_t allocated = 0;
+        size_t block_size;
+
+    public:
+        /**
+         * A position in the arena, to give back what was allocated after it.
+         */
+        struct mark {
+            size_t block;
+            size_t used;
+            size_t allocated;
+        };
+
+        /**
+         * Allocates blocks of at least `block_size` bytes, the first time memory is needed.
+         */
+        explicit csv_arena(size_t block_size = 4096);
+
+        /**
+         * Arenas are move-only: spans into an arena belong to it, so a copy could not keep
+         * them valid. A move keeps the blocks, and the spans into them.
+         */
+        csv_arena(const csv_arena&) = delete;
+        csv_arena& operator=(const csv_arena&) = delete;
+
+        csv_arena(csv_arena&&) noexcept = default;
+        csv_arena& operator=(csv_arena&&) noexcept = default;
+
+        /**
+         * Returns `size` bytes, valid until the arena is reset or rewound past them.
+         */
+        char* allocate(size_t size);
+
+        mark position() const;
+
+        /**
+         * Gives back everything allocated after `position`.
+         */
+        void rewind(const mark& position);
+
+        /**
+         * Gives back every allocation, keeping the memory.
+         */
+        void reset();
+
+        /**
+         * Returns whether `data` points into one of the arena's blocks.
+         */
+        bool contains(const char* data) const;
+
+        /**
+         * Returns the bytes allocated since the last reset.
+         */
+        size_t size() const;
+
+        /**
+         * Returns the bytes held by the arena's blocks.
+         */
+        size_t capacity() const;
+
+    };
+
+}
+
+#endif //CSV_ARENA_H
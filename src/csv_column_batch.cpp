@@ -0,0 +1,216 @@
+//
+// Created by Andres Jaimes on 09/08/25.
+//
+
+#include <climits>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "csv_column_batch.h"
+
+namespace sevilla {
+
+    namespace {
+
+        constexpr size_t alignment = 64;
+
+        void set_bit(csv_buffer& bitmap, const size_t index, const bool value) {
+            if (bitmap.size() < index / 8 + 1) {
+                bitmap.resize(index / 8 + 1);
+            }
+            if (value) {
+                bitmap.data()[index / 8] |= static_cast<uint8_t>(1u << (index % 8));
+            }
+        }
+
+    }
+
+    csv_buffer::~csv_buffer() {
+        if (bytes != nullptr) {
+            ::operator delete(bytes, std::align_val_t(alignment));
+        }
+    }
+
+    csv_buffer::csv_buffer(csv_buffer&& other) noexcept
+        : bytes(std::exchange(other.bytes, nullptr)),
+          length(std::exchange(other.length, 0)),
+          capacity(std::exchange(other.capacity, 0)) {}
+
+    csv_buffer& csv_buffer::operator=(csv_buffer&& other) noexcept {
+        if (this != &other) {
+            std::swap(bytes, other.bytes);
+            std::swap(length, other.length);
+            std::swap(capacity, other.capacity);
+        }
+        return *this;
+    }
+
+    void csv_buffer::reserve(const size_t size) {
+        if (size <= capacity) {
+            return;
+        }
+        // grow geometrically, rounded up to the alignment so the padding is always there
+        size_t grown = capacity * 2 > size ? capacity * 2 : size;
+        grown = (grown + alignment - 1) / alignment * alignment;
+
+        auto* replacement = static_cast<uint8_t*>(::operator new(grown, std::align_val_t(alignment)));
+        if (length > 0) {
+            std::memcpy(replacement, bytes, length);
+        }
+        if (bytes != nullptr) {
+            ::operator delete(bytes, std::align_val_t(alignment));
+        }
+        bytes = replacement;
+        capacity = grown;
+    }
+
+    void csv_buffer::append(const void* data, const size_t size) {
+        if (size == 0) {
+            return;
+        }
+        reserve(length + size);
+        std::memcpy(bytes + length, data, size);
+        length += size;
+    }
+
+    void csv_buffer::resize(const size_t size) {
+        reserve(size);
+        if (size > length) {
+            std::memset(bytes + length, 0, size - length);
+        }
+        length = size;
+    }
+
+    void csv_buffer::clear() {
+        length = 0;
+    }
+
+    uint8_t* csv_buffer::data() {
+        return bytes;
+    }
+
+    const uint8_t* csv_buffer::data() const {
+        return bytes;
+    }
+
+    size_t csv_buffer::size() const {
+        return length;
+    }
+
+    void csv_column_batch::set_types(const std::vector<csv_type>& types) {
+        this->types = types;
+    }
+
+    const std::vector<csv_type>& csv_column_batch::get_types() const {
+        return types;
+    }
+
+    void csv_column_batch::start(size_t width) {
+        if (width < types.size()) {
+            width = types.size();
+        }
+        table.resize(width);
+
+        for (size_t i = 0; i < width; i++) {
+            csv_column& column = table[i];
+            column.type = i < types.size() ? types[i] : csv_type::utf8;
+            column.null_count = 0;
+            column.validity.clear();
+            column.offsets.clear();
+            column.data.clear();
+            column.values.clear();
+            if (column.type == csv_type::utf8) {
+                const int32_t zero = 0;
+                column.offsets.append(&zero, sizeof(zero));
+            }
+        }
+    }
+
+    void csv_column_batch::append(const csv_parser& record) {
+        if (count == 0) {
+            start(record.size());
+        }
+        for (size_t i = 0; i < table.size(); i++) {
+            const bool present = i < record.size();
+            append_field(table[i], present ? record.view(i) : std::string_view(), present);
+        }
+        count++;
+    }
+
+    void csv_column_batch::append_field(csv_column& column, const std::string_view field, const bool present) {
+        bool valid = present;
+
+        switch (column.type) {
+            case csv_type::utf8: {
+                if (column.data.size() + field.size() > static_cast<size_t>(INT32_MAX)) {
+                    throw std::length_error("Column data exceeds 2 GB, use smaller batches");
+                }
+                column.data.append(field.data(), field.size());
+                const auto offset = static_cast<int32_t>(column.data.size());
+                column.offsets.append(&offset, sizeof(offset));
+                break;
+            }
+            case csv_type::int64:
+            case csv_type::timestamp: {
+                int64_t value = 0;
+                valid = valid && !field.empty() && (column.type == csv_type::int64
+                                                    ? parse_int64(field, value)
+                                                    : parse_timestamp(field, value));
+                if (!valid) {
+                    value = 0;
+                }
+                column.values.append(&value, sizeof(value));
+                break;
+            }
+            case csv_type::float64: {
+                double value = 0;
+                valid = valid && !field.empty() && parse_double(field, value);
+                if (!valid) {
+                    value = 0;
+                }
+                column.values.append(&value, sizeof(value));
+                break;
+            }
+            case csv_type::boolean: {
+                bool value = false;
+                valid = valid && !field.empty() && parse_bool(field, value);
+                set_bit(column.values, count, valid && value);
+                break;
+            }
+        }
+
+        set_bit(column.validity, count, valid);
+        if (!valid) {
+            column.null_count++;
+        }
+    }
+
+    size_t csv_column_batch::read(csv_reader& reader, const size_t max_rows) {
+        clear();
+        while (count < max_rows && reader.next()) {
+            append(reader.record());
+        }
+        return count;
+    }
+
+    size_t csv_column_batch::rows() const {
+        return count;
+    }
+
+    size_t csv_column_batch::columns() const {
+        return count == 0 ? 0 : table.size();
+    }
+
+    const csv_column& csv_column_batch::column(const size_t index) const {
+        if (index >= columns()) {
+            throw std::out_of_range("Column is out of range");
+        }
+        return table[index];
+    }
+
+    void csv_column_batch::clear() {
+        count = 0;
+    }
+
+}
@@ -0,0 +1,125 @@
+//
+// Created by Andres Jaimes on 09/08/25.
+//
+
+#ifndef CSV_COLUMN_BATCH_H
+#define CSV_COLUMN_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "csv_parser.h"
+#include "csv_reader.h"
+#include "csv_types.h"
+
+namespace sevilla {
+
+    /**
+     * A growable byte buffer aligned and padded to 64 bytes, as the Arrow format recommends.
+     * Clearing it keeps its memory.
+     */
+    class csv_buffer {
+
+    private:
+        uint8_t* bytes = nullptr;
+        size_t length = 0;
+        size_t capacity = 0;
+
+        void reserve(size_t size);
+
+    public:
+        csv_buffer() = default;
+        ~csv_buffer();
+
+        csv_buffer(const csv_buffer&) = delete;
+        csv_buffer& operator=(const csv_buffer&) = delete;
+        csv_buffer(csv_buffer&& other) noexcept;
+        csv_buffer& operator=(csv_buffer&& other) noexcept;
+
+        void append(const void* data, size_t size);
+
+        /**
+         * Grows the buffer to `size` bytes, zero-filling the new ones.
+         */
+        void resize(size_t size);
+
+        void clear();
+
+        uint8_t* data();
+        const uint8_t* data() const;
+        size_t size() const;
+
+    };
+
+    /**
+     * One column in Arrow layout. Every column has a validity bitmap, least significant bit
+     * first. `utf8` columns keep `rows + 1` int32 offsets into `data`; the other types keep
+     * their values in `values`: 8 bytes per row, or one bit per row for booleans.
+     */
+    struct csv_column {
+        csv_type type = csv_type::utf8;
+        size_t null_count = 0;
+        csv_buffer validity;
+        csv_buffer offsets;
+        csv_buffer data;
+        csv_buffer values;
+    };
+
+    /**
+     * Parses csv rows into columns that other engines can use without copying.
+     * Columns are `utf8` unless given a type. Typed columns hold a null for empty fields,
+     * and for fields that do not hold a value of the type.
+     */
+    class csv_column_batch {
+
+    private:
+        std::vector<csv_type> types;
+        std::vector<csv_column> table;
+        size_t count = 0;
+
+        void start(size_t width);
+
+        void append_field(csv_column& column, std::string_view field, bool present);
+
+    public:
+        /**
+         * Sets the types of the first columns, the rest are `utf8`. Takes effect on the next batch.
+         */
+        void set_types(const std::vector<csv_type>& types);
+
+        /**
+         * Returns the types set for the next batches, which may not be applied yet.
+         */
+        const std::vector<csv_type>& get_types() const;
+
+        /**
+         * Appends the last record parsed by `record`. The first row sets the number of columns:
+         * missing fields are null, and extra fields are dropped.
+         */
+        void append(const csv_parser& record);
+
+        /**
+         * Starts a new batch with up to `max_rows` records from `reader`.
+         * Returns the number of rows read.
+         */
+        size_t read(csv_reader& reader, size_t max_rows);
+
+        size_t rows() const;
+        size_t columns() const;
+
+        /**
+         * Returns a column by index.
+         */
+        const csv_column& column(size_t index) const;
+
+        /**
+         * Removes every row, keeping the allocated memory.
+         */
+        void clear();
+
+    };
+
+}
+
+#endif //CSV_COLUMN_BATCH_H
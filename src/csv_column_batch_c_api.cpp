@@ -0,0 +1,174 @@
+//
+// Created by Andres Jaimes on 09/08/25.
+//
+
+#include "c_api.h"
+#include "csv_column_batch.h"
+#include "json.hpp"
+
+thread_local sevilla::csv_reader columns_reader;
+thread_local sevilla::csv_column_batch column_batch;
+
+/**
+ * Opens a csv file for reading in column batches. With `header`, the first record names
+ * the columns and is not read as data, as in sv_csv_infer_schema.
+ */
+extern "C" DLL_EXPORT
+int sv_csv_columns_open(const char* path, const char separator, const int header) {
+    column_batch.clear();
+    column_batch.set_types({});
+
+    if (path == nullptr) {
+        return 0;
+    }
+
+    try {
+        sevilla::csv_dialect dialect;
+        dialect.separator = separator;
+        dialect.header = header != 0;
+        columns_reader.open(path, dialect);
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+/**
+ * Sets a column's type for the next batches: 0 utf8, 1 int64, 2 float64, 3 boolean, 4 timestamp.
+ */
+extern "C" DLL_EXPORT
+int sv_csv_columns_set_type(size_t column, int type) {
+    if (type < 0 || type > static_cast<int>(sevilla::csv_type::timestamp)) {
+        return 0;
+    }
+
+    try {
+        // extends the types set so far, which the batch only applies on its next read
+        std::vector<sevilla::csv_type> types = column_batch.get_types();
+        if (types.size() <= column) {
+            types.resize(column + 1, sevilla::csv_type::utf8);
+        }
+        types[column] = static_cast<sevilla::csv_type>(type);
+        column_batch.set_types(types);
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+/**
+ * Sets how malformed records are handled: 0 read them unchecked (the default), 1 skip them,
+ * 2 pad or truncate them, 3 stop. Applies until the thread changes it.
+ */
+extern "C" DLL_EXPORT
+int sv_csv_columns_set_error_policy(int policy) {
+    if (policy < 0 || policy > static_cast<int>(sevilla::csv_error_policy::abort)) {
+        return 0;
+    }
+    columns_reader.set_error_policy(static_cast<sevilla::csv_error_policy>(policy));
+    return 1;
+}
+
+/**
+ * Returns a json object with the malformed records found since the file was opened:
+ * `unterminated_quotes`, `stray_quotes`, `ragged_rows` and `skipped_rows`, and the
+ * `last_error` (`message`, `offset`, `row` and `column`) when there is one.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_columns_errors() {
+    thread_local std::string result;
+
+    const sevilla::csv_error_counts& counts = columns_reader.errors();
+    nlohmann::json j;
+    j["unterminated_quotes"] = counts.unterminated_quotes;
+    j["stray_quotes"] = counts.stray_quotes;
+    j["ragged_rows"] = counts.ragged_rows;
+    j["skipped_rows"] = counts.skipped_rows;
+    if (counts.total() > 0) {
+        const sevilla::csv_error& error = columns_reader.last_error();
+        j["last_error"] = {
+            {"message", error.message()},
+            {"offset", error.offset},
+            {"row", error.row},
+            {"column", error.column}
+        };
+    }
+    result = j.dump();
+
+    return result.c_str();
+}
+
+/**
+ * Reads the next batch of up to `max_rows` rows. Returns the number of rows read.
+ * When the error policy stops at a malformed record, the batch ends before it, and the
+ * next call resumes after it.
+ */
+extern "C" DLL_EXPORT
+size_t sv_csv_columns_read(size_t max_rows) {
+    try {
+        return column_batch.read(columns_reader, max_rows);
+    } catch (const sevilla::csv_format_error&) {
+        return column_batch.rows();
+    } catch (...) {
+        column_batch.clear();
+        return 0;
+    }
+}
+
+extern "C" DLL_EXPORT
+size_t sv_csv_columns_count() {
+    return column_batch.columns();
+}
+
+extern "C" DLL_EXPORT
+int sv_csv_columns_type(size_t column) {
+    if (column >= column_batch.columns()) {
+        return -1;
+    }
+    return static_cast<int>(column_batch.column(column).type);
+}
+
+extern "C" DLL_EXPORT
+size_t sv_csv_columns_null_count(size_t column) {
+    if (column >= column_batch.columns()) {
+        return 0;
+    }
+    return column_batch.column(column).null_count;
+}
+
+/**
+ * Returns a column's buffer, numbered as in the Arrow C data interface:
+ * 0 is the validity bitmap, 1 the offsets (utf8) or values, and 2 the utf8 data.
+ * The buffer's size in bytes is written to `length`.
+ */
+extern "C" DLL_EXPORT
+const void* sv_csv_columns_buffer(size_t column, int buffer, size_t* length) {
+    if (column >= column_batch.columns()) {
+        return nullptr;
+    }
+
+    const sevilla::csv_column& c = column_batch.column(column);
+    const bool utf8 = c.type == sevilla::csv_type::utf8;
+    const sevilla::csv_buffer* selected = nullptr;
+
+    if (buffer == 0) {
+        selected = &c.validity;
+    } else if (buffer == 1) {
+        selected = utf8 ? &c.offsets : &c.values;
+    } else if (buffer == 2 && utf8) {
+        selected = &c.data;
+    } else {
+        return nullptr;
+    }
+
+    if (length != nullptr) {
+        *length = selected->size();
+    }
+    return selected->data();
+}
+
+extern "C" DLL_EXPORT
+void sv_csv_columns_close() {
+    column_batch.clear();
+    columns_reader.close();
+}
@@ -0,0 +1,106 @@
+//
+// Created by Andres Jaimes on 04/10/25.
+//
+
+#include <cstring>
+#include "csv_error.h"
+
+namespace sevilla {
+
+    namespace {
+
+        const char* describe(const csv_error_kind kind) {
+            switch (kind) {
+                case csv_error_kind::unterminated_quote: return "Unterminated quote";
+                case csv_error_kind::stray_quote: return "Stray quote";
+                default: return "Ragged row";
+            }
+        }
+
+    }
+
+    std::string csv_error::message() const {
+        return std::string(describe(kind)) + " at row " + std::to_string(row) + ", column " + std::to_string(column)
+               + ", offset " + std::to_string(offset);
+    }
+
+    size_t csv_error_counts::total() const {
+        return unterminated_quotes + stray_quotes + ragged_rows;
+    }
+
+    csv_format_error::csv_format_error(const csv_error& error) : std::runtime_error(error.message()), details(error) {}
+
+    const csv_error& csv_format_error::error() const {
+        return details;
+    }
+
+    bool csv_validator::check(const std::string_view record, const char separator, const char quote, size_t& fields,
+                              csv_error& error) const {
+        const char* data = record.data();
+        size_t size = record.size();
+
+        // the line break is not part of the last field
+        if (size > 0 && data[size - 1] == '\n') {
+            size--;
+        }
+        if (size > 0 && data[size - 1] == '\r') {
+            size--;
+        }
+
+        const auto fail = [&](const csv_error_kind kind, const size_t offset) {
+            error.kind = kind;
+            error.offset = offset;
+            error.row = 0;
+            error.column = fields - 1;
+            return false;
+        };
+
+        fields = 1;
+        size_t position = 0;
+        while (true) {
+            if (position < size && data[position] == quote) {
+                // find the closing quote, stepping over doubled ones
+                size_t closing = position + 1;
+                while (true) {
+                    const void* found = std::memchr(data + closing, quote, size - closing);
+                    if (found == nullptr) {
+                        return fail(csv_error_kind::unterminated_quote, position);
+                    }
+                    closing = static_cast<const char*>(found) - data;
+                    if (closing + 1 < size && data[closing + 1] == quote) {
+                        closing += 2;
+                        continue;
+                    }
+                    break;
+                }
+
+                position = closing + 1;
+                if (position == size) {
+                    return true;
+                }
+                if (data[position] != separator) {
+                    return fail(csv_error_kind::stray_quote, closing);
+                }
+            } else {
+                // carriage returns inside unquoted fields are kept as text
+                while (true) {
+                    position += scanner.find_special(data + position, size - position, separator, quote);
+                    if (position >= size) {
+                        return true;
+                    }
+                    if (data[position] == separator) {
+                        break;
+                    }
+                    if (data[position] == quote) {
+                        return fail(csv_error_kind::stray_quote, position);
+                    }
+                    position++;
+                }
+            }
+
+            fields++;
+            position++;
+        }
+    }
+
+}
@@ -0,0 +1,126 @@
+//
+// Created by Andres Jaimes on 04/10/25.
+//
+
+#ifndef CSV_ERROR_H
+#define CSV_ERROR_H
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "csv_scanner.h"
+
+namespace sevilla {
+
+    enum class csv_error_kind {
+        /**
+         * A quoted field that is never closed, and runs to the end of the data.
+         */
+        unterminated_quote,
+
+        /**
+         * A quote inside an unquoted field, or text after the closing quote of a field.
+         */
+        stray_quote,
+
+        /**
+         * A record with another number of fields than the first one.
+         */
+        ragged_row
+    };
+
+    /**
+     * What a reader does with malformed records.
+     */
+    enum class csv_error_policy {
+        /**
+         * Reads them as well as it can, without checking. The default.
+         */
+        lenient,
+
+        /**
+         * Counts them and leaves them out.
+         */
+        skip,
+
+        /**
+         * Counts them and reads them anyway, padding short records with empty fields and
+         * dropping the extra fields of long ones.
+         */
+        pad,
+
+        /**
+         * Throws csv_format_error.
+         */
+        abort
+    };
+
+    struct csv_error {
+        csv_error_kind kind = csv_error_kind::unterminated_quote;
+
+        /**
+         * The byte offset of the error: the opening quote of an unterminated field, the stray
+         * quote, or the start of a ragged record.
+         */
+        size_t offset = 0;
+
+        /**
+         * The record and field where the error is, counted from 0. For a ragged record, the
+         * first field it is missing or should not have.
+         */
+        size_t row = 0;
+        size_t column = 0;
+
+        std::string message() const;
+    };
+
+    /**
+     * Malformed records a reader has found since it was opened.
+     */
+    struct csv_error_counts {
+        size_t unterminated_quotes = 0;
+        size_t stray_quotes = 0;
+        size_t ragged_rows = 0;
+
+        /**
+         * The records left out by the skip policy.
+         */
+        size_t skipped_rows = 0;
+
+        size_t total() const;
+    };
+
+    class csv_format_error : public std::runtime_error {
+
+    private:
+        csv_error details;
+
+    public:
+        explicit csv_format_error(const csv_error& error);
+
+        const csv_error& error() const;
+
+    };
+
+    /**
+     * Checks that a record follows RFC 4180 quoting: a field is either unquoted, without
+     * quotes in it, or enclosed in quotes, with the ones inside doubled.
+     */
+    class csv_validator {
+
+    private:
+        csv_scanner scanner;
+
+    public:
+        /**
+         * Checks the record in `record`, line break included, and counts its fields into
+         * `fields`. Returns false on the first error, described in `error` with an offset
+         * relative to the record and no row.
+         */
+        bool check(std::string_view record, char separator, char quote, size_t& fields, csv_error& error) const;
+
+    };
+
+}
+
+#endif //CSV_ERROR_H
@@ -0,0 +1,254 @@
+//
+// Created by Andres Jaimes on 11/10/25.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "csv_follower.h"
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+
+namespace sevilla {
+
+    namespace {
+
+        constexpr size_t chunk_size = 64 * 1024;
+
+        /**
+         * How often the file is checked without inotify, and how long inotify is waited on
+         * before checking whether the file was replaced.
+         */
+        constexpr int poll_interval_ms = 50;
+        constexpr int rotation_check_ms = 1000;
+
+    }
+
+    csv_follower::csv_follower() : stream(',', collect()), chunk(chunk_size) {}
+
+    csv_follower::~csv_follower() {
+        close();
+    }
+
+    void csv_follower::open(const std::string& path, const char separator, const size_t offset) {
+        close();
+        this->path = path;
+        stream = csv_stream_parser(separator, collect());
+        stream.set_quote(quote);
+        open_file(offset);
+    }
+
+    csv_stream_parser::record_callback csv_follower::collect() {
+        return [this](const csv_parser& record) {
+            target->append(record);
+            appended++;
+        };
+    }
+
+    void csv_follower::set_quote(const char quote) {
+        this->quote = quote;
+        stream.set_quote(quote);
+    }
+
+    void csv_follower::close() {
+        close_file();
+        stream.reset();
+        position = 0;
+    }
+
+    void csv_follower::open_file(const size_t offset) {
+#if defined(_WIN32)
+        fd = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+        if (fd < 0) {
+            throw std::runtime_error("Unable to open file: " + path);
+        }
+        if (_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) < 0) {
+            close_file();
+            throw std::runtime_error("Unable to seek file: " + path);
+        }
+#else
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Unable to open file: " + path);
+        }
+        if (lseek(fd, static_cast<off_t>(offset), SEEK_SET) < 0) {
+            close_file();
+            throw std::runtime_error("Unable to seek file: " + path);
+        }
+#endif
+        position = offset;
+
+#if defined(__linux__)
+        // without inotify, the file size is polled
+        notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (notify >= 0) {
+            const int watch = inotify_add_watch(notify, path.c_str(),
+                                                IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF);
+            if (watch < 0) {
+                ::close(notify);
+                notify = -1;
+            }
+        }
+#endif
+    }
+
+    void csv_follower::close_file() {
+#if defined(_WIN32)
+        if (fd >= 0) {
+            _close(fd);
+        }
+#else
+        if (notify >= 0) {
+            ::close(notify);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+#endif
+        fd = -1;
+        notify = -1;
+    }
+
+    size_t csv_follower::file_size() const {
+#if defined(_WIN32)
+        struct _stat64 info {};
+        if (_fstat64(fd, &info) != 0) {
+            throw std::runtime_error("Unable to read file size: " + path);
+        }
+#else
+        struct stat info {};
+        if (fstat(fd, &info) != 0) {
+            throw std::runtime_error("Unable to read file size: " + path);
+        }
+#endif
+        return static_cast<size_t>(info.st_size);
+    }
+
+    bool csv_follower::replaced() const {
+#if defined(_WIN32)
+        return false;
+#else
+        struct stat current {};
+        struct stat opened {};
+        // a file renamed away may not have a successor yet
+        if (stat(path.c_str(), &current) != 0 || fstat(fd, &opened) != 0) {
+            return false;
+        }
+        return current.st_ino != opened.st_ino || current.st_dev != opened.st_dev;
+#endif
+    }
+
+    void csv_follower::restart(const size_t offset) {
+        close_file();
+        stream.reset();
+        open_file(offset);
+    }
+
+    size_t csv_follower::read(csv_table& table, const size_t max_bytes) {
+        if (fd < 0) {
+            return 0;
+        }
+
+        target = &table;
+        appended = 0;
+
+        if (file_size() < position) {
+            restart(0);
+        }
+
+        size_t total = 0;
+        while (total < max_bytes) {
+#if defined(_WIN32)
+            const int count = _read(fd, chunk.data(), static_cast<unsigned int>(chunk.size()));
+#else
+            const ssize_t count = ::read(fd, chunk.data(), chunk.size());
+#endif
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                target = nullptr;
+                throw std::runtime_error("Unable to read file: " + path);
+            }
+            if (count == 0) {
+                // once the old file is read to its end, continue with the one that replaced it
+                if (!replaced()) {
+                    break;
+                }
+                restart(0);
+                continue;
+            }
+
+            position += static_cast<size_t>(count);
+            total += static_cast<size_t>(count);
+            stream.feed(chunk.data(), static_cast<size_t>(count));
+        }
+
+        target = nullptr;
+        return appended;
+    }
+
+    bool csv_follower::wait(const int timeout_ms) {
+        if (fd < 0) {
+            return false;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(0, timeout_ms));
+        while (true) {
+            if (file_size() != position || replaced()) {
+                return true;
+            }
+
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0) {
+                return false;
+            }
+
+#if defined(__linux__)
+            if (notify >= 0) {
+                pollfd request{notify, POLLIN, 0};
+                if (::poll(&request, 1, static_cast<int>(std::min<long long>(left, rotation_check_ms))) > 0) {
+                    // the events only wake us up, the file size tells what changed
+                    char events[4096];
+                    while (::read(notify, events, sizeof(events)) > 0) {}
+                }
+                continue;
+            }
+#endif
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::min<long long>(left, poll_interval_ms)));
+        }
+    }
+
+    size_t csv_follower::poll(csv_table& table, const int timeout_ms) {
+        const size_t count = read(table);
+        if (count > 0 || !wait(timeout_ms)) {
+            return count;
+        }
+        return read(table);
+    }
+
+    size_t csv_follower::offset() const {
+        return position - stream.pending_size();
+    }
+
+    size_t csv_follower::rows() const {
+        return stream.rows();
+    }
+
+}
@@ -0,0 +1,121 @@
+//
+// Created by Andres Jaimes on 11/10/25.
+//
+
+#ifndef CSV_FOLLOWER_H
+#define CSV_FOLLOWER_H
+
+#include <string>
+#include <vector>
+#include "csv_stream_parser.h"
+#include "csv_table.h"
+
+namespace sevilla {
+
+    /**
+     * Follows a csv file that other processes keep appending to, like `tail -f`. Every read
+     * parses only the bytes appended since the last one, and a record still being written
+     * is held back until its line break arrives. Waiting for growth uses inotify on Linux,
+     * and polls the file size elsewhere.
+     *
+     * A file truncated in place is read again from its start. On POSIX systems, so is a file
+     * replaced by another one at the same path, as log rotation does, once the old one has
+     * been read to its end.
+     */
+    class csv_follower {
+
+    private:
+        std::string path;
+        int fd = -1;
+
+        /**
+         * The inotify instance watching the file, or -1 when polling.
+         */
+        int notify = -1;
+
+        char quote = '"';
+
+        csv_stream_parser stream;
+        csv_table* target = nullptr;
+        size_t appended = 0;
+
+        /**
+         * Bytes read from the file, including those of a held back record.
+         */
+        size_t position = 0;
+
+        std::vector<char> chunk;
+
+        /**
+         * Returns the stream callback, which appends records to `target`.
+         */
+        csv_stream_parser::record_callback collect();
+
+        void open_file(size_t offset);
+        void close_file();
+
+        /**
+         * Returns the size of the open file, and whether another file took its path.
+         */
+        size_t file_size() const;
+        bool replaced() const;
+
+        void restart(size_t offset);
+
+    public:
+        csv_follower();
+        ~csv_follower();
+
+        csv_follower(const csv_follower&) = delete;
+        csv_follower& operator=(const csv_follower&) = delete;
+
+        /**
+         * Starts following a file from byte `offset`, which should be the start of a record,
+         * usually an `offset()` saved earlier. Throws std::runtime_error when the file cannot
+         * be opened.
+         */
+        void open(const std::string& path, char separator, size_t offset = 0);
+
+        /**
+         * Sets the character that encloses fields, for this and later files.
+         * See `csv_parser::set_quote`.
+         */
+        void set_quote(char quote);
+
+        void close();
+
+        /**
+         * Appends the records completed since the last read to `table`, without waiting,
+         * reading at most about `max_bytes`. Returns the number of records appended.
+         */
+        size_t read(csv_table& table, size_t max_bytes = 16 * 1024 * 1024);
+
+        /**
+         * Waits up to `timeout_ms` milliseconds for the file to change. Returns whether it
+         * did, or whether there already was unread data.
+         */
+        bool wait(int timeout_ms);
+
+        /**
+         * Reads new records, waiting up to `timeout_ms` milliseconds for some when there
+         * are none yet. Returns the number of records appended to `table`.
+         */
+        size_t poll(csv_table& table, int timeout_ms);
+
+        /**
+         * Returns the offset just past the last complete record read, where following can
+         * resume after a restart.
+         */
+        size_t offset() const;
+
+        /**
+         * Returns the number of records read since the file was opened, or since it was
+         * read again from its start.
+         */
+        size_t rows() const;
+
+    };
+
+}
+
+#endif //CSV_FOLLOWER_H
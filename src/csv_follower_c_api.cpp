@@ -0,0 +1,112 @@
+//
+// Created by Andres Jaimes on 11/10/25.
+//
+
+#include "c_api.h"
+#include "csv_follower.h"
+
+thread_local sevilla::csv_follower follower;
+thread_local sevilla::csv_table follow_batch;
+thread_local std::string follow_error;
+
+/**
+ * Starts following a file that other processes append to, from byte `offset`: 0, or an
+ * offset from sv_csv_follow_offset to resume where a previous run stopped. Returns 1 on
+ * success and 0 when the file cannot be opened; sv_csv_follow_error tells why.
+ */
+extern "C" DLL_EXPORT
+int sv_csv_follow_open(const char* path, const char separator, const size_t offset) {
+    follow_batch.clear();
+    follow_error.clear();
+
+    if (path == nullptr) {
+        follow_error = make_error("No file given");
+        return 0;
+    }
+
+    try {
+        follower.open(path, separator, offset);
+        return 1;
+    } catch (std::exception& e) {
+        follow_error = make_error(e.what());
+    } catch (...) {
+        follow_error = make_error("Unknown exception");
+    }
+    return 0;
+}
+
+/**
+ * Reads the records appended since the last call into a new batch, waiting up to
+ * `timeout_ms` milliseconds for some when there are none. A record still being written is
+ * held back until it is complete. Returns the number of rows in the batch. A return of 0
+ * is also how a failed read shows; sv_csv_follow_error tells them apart.
+ */
+extern "C" DLL_EXPORT
+size_t sv_csv_follow_poll(const int timeout_ms) {
+    follow_batch.clear();
+    follow_error.clear();
+
+    try {
+        return follower.poll(follow_batch, timeout_ms);
+    } catch (std::exception& e) {
+        follow_error = make_error(e.what());
+    } catch (...) {
+        follow_error = make_error("Unknown exception");
+    }
+    follow_batch.clear();
+    return 0;
+}
+
+/**
+ * Returns a json object with the `error` that made the last sv_csv_follow_open or
+ * sv_csv_follow_poll call fail, or null when it succeeded.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_follow_error() {
+    return follow_error.empty() ? nullptr : follow_error.c_str();
+}
+
+/**
+ * Returns the offset just past the last complete record read.
+ */
+extern "C" DLL_EXPORT
+size_t sv_csv_follow_offset() {
+    return follower.offset();
+}
+
+/**
+ * Returns the field bytes of the last batch, writing their size to `length`.
+ * See sv_csv_batch_data.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_follow_data(size_t* length) {
+    if (length != nullptr) {
+        *length = follow_batch.data().size();
+    }
+    return follow_batch.data().data();
+}
+
+/**
+ * Returns the field offsets of the last batch, writing the number of fields to `count`.
+ */
+extern "C" DLL_EXPORT
+const size_t* sv_csv_follow_field_offsets(size_t* count) {
+    if (count != nullptr) {
+        *count = follow_batch.fields().size() - 1;
+    }
+    return follow_batch.fields().data();
+}
+
+/**
+ * Returns the row offsets of the last batch: one more than the number of rows.
+ */
+extern "C" DLL_EXPORT
+const size_t* sv_csv_follow_row_offsets() {
+    return follow_batch.row_fields().data();
+}
+
+extern "C" DLL_EXPORT
+void sv_csv_follow_close() {
+    follow_batch.clear();
+    follower.close();
+}
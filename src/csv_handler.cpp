@@ -0,0 +1,32 @@
+//
+// Created by Andres Jaimes on 13/09/25.
+//
+
+#include "csv_handler.h"
+
+namespace sevilla {
+
+    size_t parse_csv(csv_parser& parser, const std::string_view data, const char separator, csv_handler& handler) {
+        size_t position = 0;
+        size_t rows = 0;
+
+        while (position < data.size()) {
+            position += parser.parse_record(data.substr(position), separator);
+            if (parser.accepted()) {
+                emit_csv_row(parser, rows++, handler);
+            }
+        }
+
+        parser.reset();
+        return rows;
+    }
+
+    void emit_csv_row(const csv_parser& record, const size_t row, csv_handler& handler) {
+        for (size_t column = 0; column < record.size(); column++) {
+            const std::string_view field = record.view(column);
+            handler.on_field(row, column, field.data(), field.size());
+        }
+        handler.on_row_end(row);
+    }
+
+}
@@ -0,0 +1,44 @@
+//
+// Created by Andres Jaimes on 13/09/25.
+//
+
+#ifndef CSV_HANDLER_H
+#define CSV_HANDLER_H
+
+#include <string_view>
+#include "csv_parser.h"
+
+namespace sevilla {
+
+    /**
+     * Receives csv data as events, field by field, instead of as stored records. Fields are
+     * spans into the parsed data, or into the parser's unescape buffer, and are only valid
+     * during the call. They are not null-terminated.
+     */
+    class csv_handler {
+
+    public:
+        virtual ~csv_handler() = default;
+
+        virtual void on_field(size_t row, size_t column, const char* data, size_t size) = 0;
+
+        virtual void on_row_end(size_t /* row */) {}
+
+    };
+
+    /**
+     * Parses every record of `data` with `parser`, so its projection, filters and quote
+     * apply, and passes the fields of the records that pass the filters to `handler`.
+     * Rows are numbered from 0, counting only the rows passed on. Nothing is allocated
+     * per record once the parser's buffers have grown. Returns the number of rows.
+     */
+    size_t parse_csv(csv_parser& parser, std::string_view data, char separator, csv_handler& handler);
+
+    /**
+     * Passes the fields of the last record parsed by `record` to `handler`, as row `row`.
+     */
+    void emit_csv_row(const csv_parser& record, size_t row, csv_handler& handler);
+
+}
+
+#endif //CSV_HANDLER_H
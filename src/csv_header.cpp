@@ -0,0 +1,74 @@
+//
+// Created by Andres Jaimes on 16/08/25.
+//
+
+#include <stdexcept>
+#include "csv_header.h"
+
+namespace sevilla {
+
+    csv_header::csv_header(const std::vector<std::string_view>& names) {
+        size_t capacity = 8;
+        while (capacity < names.size() * 2) {
+            capacity *= 2;
+        }
+        slots.assign(capacity, slot{0, -1});
+        this->names.reserve(names.size());
+
+        for (const std::string_view name : names) {
+            const auto index = static_cast<int32_t>(this->names.size());
+            this->names.emplace_back(name);
+
+            if (find(name) != npos) {
+                continue;
+            }
+            const uint32_t h = hash(name);
+            size_t position = h & (capacity - 1);
+            while (slots[position].index >= 0) {
+                position = (position + 1) & (capacity - 1);
+            }
+            slots[position] = slot{h, index};
+        }
+    }
+
+    uint32_t csv_header::hash(const std::string_view name) {
+        // fnv-1a
+        uint32_t h = 2166136261u;
+        for (const char c : name) {
+            h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+        }
+        return h;
+    }
+
+    size_t csv_header::find(const std::string_view name) const {
+        if (slots.empty()) {
+            return npos;
+        }
+
+        const uint32_t h = hash(name);
+        const size_t mask = slots.size() - 1;
+        for (size_t position = h & mask; slots[position].index >= 0; position = (position + 1) & mask) {
+            const slot& s = slots[position];
+            if (s.hash == h && names[s.index] == name) {
+                return static_cast<size_t>(s.index);
+            }
+        }
+        return npos;
+    }
+
+    const std::string& csv_header::name(const size_t index) const {
+        if (index >= names.size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        return names[index];
+    }
+
+    size_t csv_header::size() const {
+        return names.size();
+    }
+
+    bool csv_header::empty() const {
+        return names.empty();
+    }
+
+}
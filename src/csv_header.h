@@ -0,0 +1,65 @@
+//
+// Created by Andres Jaimes on 16/08/25.
+//
+
+#ifndef CSV_HEADER_H
+#define CSV_HEADER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sevilla {
+
+    /**
+     * Column names of a csv file, resolved to column indexes through a flat open-addressing
+     * table that is built once. A lookup hashes the name and usually compares a single entry.
+     * When a name repeats, the first column with it wins.
+     */
+    class csv_header {
+
+    private:
+        struct slot {
+            uint32_t hash;
+            int32_t index;
+        };
+
+        std::vector<std::string> names;
+
+        /**
+         * Power-of-two table, at most half full. Empty slots have an index of -1.
+         */
+        std::vector<slot> slots;
+
+        static uint32_t hash(std::string_view name);
+
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        csv_header() = default;
+
+        explicit csv_header(const std::vector<std::string_view>& names);
+
+        /**
+         * Returns the index of a column, or `npos` when no column has that name.
+         */
+        size_t find(std::string_view name) const;
+
+        /**
+         * Returns the name of a column.
+         */
+        const std::string& name(size_t index) const;
+
+        /**
+         * Returns the number of columns.
+         */
+        size_t size() const;
+
+        bool empty() const;
+
+    };
+
+}
+
+#endif //CSV_HEADER_H
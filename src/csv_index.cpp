@@ -0,0 +1,136 @@
+//
+// Created by Andres Jaimes on 09/08/25.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "csv_index.h"
+
+namespace sevilla {
+
+    namespace {
+
+        constexpr char magic[8] = {'S', 'V', 'C', 'S', 'V', 'I', 'X', '1'};
+
+    }
+
+    csv_index::csv_index(const size_t stride) : stride(stride) {
+        if (stride == 0) {
+            throw std::invalid_argument("Index stride must be greater than 0");
+        }
+    }
+
+    void csv_index::build(const char* data, const size_t size, const char quote) {
+        offsets.clear();
+        records = 0;
+        source_size = size;
+
+        size_t position = 0;
+        size_t record_start = 0;
+        bool in_quotes = false;
+
+        // a line feed ends a record when the quotes before it, since the record started,
+        // are balanced. Escaped quotes come in pairs, so they never change the parity.
+        while (position < size) {
+            const void* found = std::memchr(data + position, '\n', size - position);
+            const size_t end = found != nullptr ? static_cast<const char*>(found) - data : size;
+            if (std::count(data + position, data + end, quote) % 2 == 1) {
+                in_quotes = !in_quotes;
+            }
+            position = end + 1;
+
+            if (in_quotes && found != nullptr) {
+                continue;
+            }
+            if (records % stride == 0) {
+                offsets.push_back(record_start);
+            }
+            records++;
+            record_start = position;
+        }
+    }
+
+    void csv_index::save(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Unable to create index file: " + path);
+        }
+
+        const uint64_t header[4] = {stride, records, source_size, offsets.size()};
+        file.write(magic, sizeof(magic));
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(offsets.data()),
+                   static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+
+        if (!file) {
+            throw std::runtime_error("Unable to write index file: " + path);
+        }
+    }
+
+    void csv_index::load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Unable to open index file: " + path);
+        }
+
+        char signature[sizeof(magic)] = {};
+        uint64_t header[4] = {};
+        file.read(signature, sizeof(signature));
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!file || std::memcmp(signature, magic, sizeof(magic)) != 0 || header[0] == 0 ||
+            header[3] != (header[1] + header[0] - 1) / header[0]) {
+            throw std::runtime_error("Not a csv index file: " + path);
+        }
+
+        // the count comes from the file, so check it fits in what follows before allocating
+        const std::streampos start = file.tellg();
+        file.seekg(0, std::ios::end);
+        const uint64_t remaining = static_cast<uint64_t>(file.tellg() - start);
+        file.seekg(start);
+        if (!file || header[3] > remaining / sizeof(uint64_t)) {
+            throw std::runtime_error("Truncated csv index file: " + path);
+        }
+
+        std::vector<uint64_t> loaded(header[3]);
+        file.read(reinterpret_cast<char*>(loaded.data()), static_cast<std::streamsize>(loaded.size() * sizeof(uint64_t)));
+        if (!file) {
+            throw std::runtime_error("Truncated csv index file: " + path);
+        }
+
+        // seeking trusts the offsets, so they must stay inside the data and never go back
+        uint64_t previous = 0;
+        for (const uint64_t offset : loaded) {
+            if (offset < previous || offset > header[2]) {
+                throw std::runtime_error("Corrupt csv index file: " + path);
+            }
+            previous = offset;
+        }
+
+        stride = header[0];
+        records = header[1];
+        source_size = header[2];
+        offsets = std::move(loaded);
+    }
+
+    uint64_t csv_index::checkpoint(const size_t row) const {
+        if (row >= records) {
+            throw std::out_of_range("Row " + std::to_string(row) + " is out of range");
+        }
+        return offsets[row / stride];
+    }
+
+    size_t csv_index::get_stride() const {
+        return stride;
+    }
+
+    size_t csv_index::rows() const {
+        return records;
+    }
+
+    uint64_t csv_index::size() const {
+        return source_size;
+    }
+
+}
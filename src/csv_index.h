@@ -0,0 +1,79 @@
+//
+// Created by Andres Jaimes on 09/08/25.
+//
+
+#ifndef CSV_INDEX_H
+#define CSV_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sevilla {
+
+    /**
+     * Byte offsets of every `stride`th record of csv data, for jumping to a row without
+     * parsing everything before it. Line feeds inside quotes do not end records, just as
+     * with `csv_parser::parse_record`. An index can be saved next to its file and loaded
+     * back, as long as the file does not change.
+     */
+    class csv_index {
+
+    private:
+        size_t stride = 1024;
+        size_t records = 0;
+        uint64_t source_size = 0;
+
+        /**
+         * Offset of record `i * stride`, for every checkpoint.
+         */
+        std::vector<uint64_t> offsets;
+
+    public:
+        /**
+         * `stride` trades index size for the records scanned after each jump. Throws if it is 0.
+         */
+        explicit csv_index(size_t stride = 1024);
+
+        /**
+         * Indexes `size` bytes of csv data. See `csv_reader::build_index` for mapped files.
+         */
+        void build(const char* data, size_t size, char quote = '"');
+
+        /**
+         * Writes the index to a file. Throws std::runtime_error on failure.
+         */
+        void save(const std::string& path) const;
+
+        /**
+         * Reads an index written by `save`. Throws std::runtime_error when the file cannot
+         * be read, is not an index, or has offsets out of order or past the data.
+         */
+        void load(const std::string& path);
+
+        /**
+         * Returns the offset of the closest checkpoint at or before `row`, which is record
+         * `row - row % stride`. Throws std::out_of_range when `row` is not in the data.
+         */
+        uint64_t checkpoint(size_t row) const;
+
+        /**
+         * Returns the distance between checkpoints, in records.
+         */
+        size_t get_stride() const;
+
+        /**
+         * Returns the number of records in the indexed data.
+         */
+        size_t rows() const;
+
+        /**
+         * Returns the size of the indexed data, to check that an index belongs to a file.
+         */
+        uint64_t size() const;
+
+    };
+
+}
+
+#endif //CSV_INDEX_H
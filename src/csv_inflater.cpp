@@ -0,0 +1,125 @@
+//
+// Created by Andres Jaimes on 20/09/25.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <zlib.h>
+#include "csv_inflater.h"
+
+namespace sevilla {
+
+    csv_inflater::csv_inflater(const char* data, const size_t size, const size_t chunk_size, const size_t max_chunks)
+        : input(reinterpret_cast<const unsigned char*>(data)), input_size(size),
+          chunk_size(chunk_size > 0 ? chunk_size : 1), max_chunks(max_chunks > 0 ? max_chunks : 1) {
+        worker = std::thread(&csv_inflater::run, this);
+    }
+
+    csv_inflater::~csv_inflater() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        changed.notify_all();
+        worker.join();
+    }
+
+    bool csv_inflater::is_gzip(const char* data, const size_t size) {
+        return data != nullptr && size >= 2 && static_cast<unsigned char>(data[0]) == 0x1f &&
+               static_cast<unsigned char>(data[1]) == 0x8b;
+    }
+
+    bool csv_inflater::push(std::string chunk) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return stopped || chunks.size() < max_chunks; });
+        if (stopped) {
+            return false;
+        }
+        chunks.push_back(std::move(chunk));
+        changed.notify_all();
+        return true;
+    }
+
+    void csv_inflater::run() {
+        z_stream stream{};
+        // 15 window bits, plus 32 to accept both gzip and zlib headers
+        if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::make_exception_ptr(std::runtime_error("Unable to start decompression"));
+            done = true;
+            changed.notify_all();
+            return;
+        }
+
+        try {
+            size_t offset = 0;
+            std::string chunk(chunk_size, '\0');
+            stream.next_out = reinterpret_cast<Bytef*>(chunk.data());
+            stream.avail_out = static_cast<uInt>(chunk.size());
+
+            while (true) {
+                // zlib counts input in 32-bit units, so large inputs are fed in pieces
+                if (stream.avail_in == 0 && offset < input_size) {
+                    const size_t piece = std::min<size_t>(input_size - offset, 1u << 30);
+                    stream.next_in = const_cast<Bytef*>(input + offset);
+                    stream.avail_in = static_cast<uInt>(piece);
+                    offset += piece;
+                }
+
+                const int status = inflate(&stream, Z_NO_FLUSH);
+                if (status == Z_STREAM_END) {
+                    if (stream.avail_in == 0 && offset == input_size) {
+                        break;
+                    }
+                    // another gzip member follows
+                    inflateReset(&stream);
+                } else if (status == Z_BUF_ERROR && stream.avail_out > 0) {
+                    throw std::runtime_error("Truncated compressed data");
+                } else if (status != Z_OK && status != Z_BUF_ERROR) {
+                    throw std::runtime_error(std::string("Invalid compressed data: ") +
+                                             (stream.msg != nullptr ? stream.msg : "unknown error"));
+                }
+
+                if (stream.avail_out == 0) {
+                    if (!push(std::move(chunk))) {
+                        inflateEnd(&stream);
+                        return;
+                    }
+                    chunk.assign(chunk_size, '\0');
+                    stream.next_out = reinterpret_cast<Bytef*>(chunk.data());
+                    stream.avail_out = static_cast<uInt>(chunk.size());
+                }
+            }
+
+            chunk.resize(chunk.size() - stream.avail_out);
+            if (!chunk.empty()) {
+                push(std::move(chunk));
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+        }
+
+        inflateEnd(&stream);
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        changed.notify_all();
+    }
+
+    bool csv_inflater::next(std::string& chunk) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return !chunks.empty() || done; });
+
+        if (!chunks.empty()) {
+            chunk = std::move(chunks.front());
+            chunks.pop_front();
+            changed.notify_all();
+            return true;
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return false;
+    }
+
+}
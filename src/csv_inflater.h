@@ -0,0 +1,71 @@
+//
+// Created by Andres Jaimes on 20/09/25.
+//
+
+#ifndef CSV_INFLATER_H
+#define CSV_INFLATER_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace sevilla {
+
+    /**
+     * Decompresses gzip or zlib data on a thread of its own, into a bounded queue of chunks,
+     * so inflating and parsing overlap. Concatenated gzip members are read one after the other.
+     */
+    class csv_inflater {
+
+    private:
+        const unsigned char* input;
+        size_t input_size;
+        size_t chunk_size;
+        size_t max_chunks;
+
+        std::deque<std::string> chunks;
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool done = false;
+        bool stopped = false;
+        std::exception_ptr error;
+        std::thread worker;
+
+        void run();
+
+        /**
+         * Queues a chunk, waiting while the queue is full. Returns false when stopped.
+         */
+        bool push(std::string chunk);
+
+    public:
+        /**
+         * Starts inflating `size` bytes, which must outlive the inflater. At most `max_chunks`
+         * chunks of `chunk_size` bytes are held in memory.
+         */
+        csv_inflater(const char* data, size_t size, size_t chunk_size = 256 * 1024, size_t max_chunks = 4);
+
+        ~csv_inflater();
+
+        csv_inflater(const csv_inflater&) = delete;
+        csv_inflater& operator=(const csv_inflater&) = delete;
+
+        /**
+         * Moves the next chunk into `chunk`, waiting for it. Returns false at the end of the
+         * data. Throws std::runtime_error when the data is not valid compressed data.
+         */
+        bool next(std::string& chunk);
+
+        /**
+         * Returns whether `data` starts with the gzip magic number.
+         */
+        static bool is_gzip(const char* data, size_t size);
+
+    };
+
+}
+
+#endif //CSV_INFLATER_H
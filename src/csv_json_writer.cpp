@@ -0,0 +1,429 @@
+//
+// Created by Andres Jaimes on 16/10/25.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include "csv_json_writer.h"
+#include "csv_reader.h"
+#include "csv_schema.h"
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace sevilla {
+
+    namespace {
+
+        /**
+         * For every byte, the character that follows the backslash of its escape, `u` for
+         * the `\u00XX` form, or 0 when it is copied as is.
+         */
+        struct escape_table {
+            char escapes[256] = {};
+
+            escape_table() {
+                for (int c = 0; c < 0x20; c++) {
+                    escapes[c] = 'u';
+                }
+                escapes[static_cast<unsigned char>('\b')] = 'b';
+                escapes[static_cast<unsigned char>('\f')] = 'f';
+                escapes[static_cast<unsigned char>('\n')] = 'n';
+                escapes[static_cast<unsigned char>('\r')] = 'r';
+                escapes[static_cast<unsigned char>('\t')] = 't';
+                escapes[static_cast<unsigned char>('"')] = '"';
+                escapes[static_cast<unsigned char>('\\')] = '\\';
+            }
+        };
+
+        const escape_table json_escapes;
+
+        bool is_digit(const char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        /**
+         * Returns whether `field` is already a JSON number, so it can be copied as is.
+         * JSON takes no plus sign, leading zeros, or bare decimal points.
+         */
+        bool is_json_number(const std::string_view field) {
+            size_t i = 0;
+            const size_t n = field.size();
+
+            if (i < n && field[i] == '-') {
+                i++;
+            }
+            if (i < n && field[i] == '0') {
+                i++;
+            } else if (i < n && is_digit(field[i])) {
+                while (i < n && is_digit(field[i])) {
+                    i++;
+                }
+            } else {
+                return false;
+            }
+
+            if (i < n && field[i] == '.') {
+                const size_t start = ++i;
+                while (i < n && is_digit(field[i])) {
+                    i++;
+                }
+                if (i == start) {
+                    return false;
+                }
+            }
+
+            if (i < n && (field[i] == 'e' || field[i] == 'E')) {
+                i++;
+                if (i < n && (field[i] == '+' || field[i] == '-')) {
+                    i++;
+                }
+                const size_t start = i;
+                while (i < n && is_digit(field[i])) {
+                    i++;
+                }
+                if (i == start) {
+                    return false;
+                }
+            }
+
+            return i == n;
+        }
+
+        /**
+         * The most bytes a field can take: every byte escaped as `\u00XX`, plus room for
+         * its quotes and comma, or for a reformatted number.
+         */
+        size_t value_bound(const std::string_view field) {
+            return 6 * field.size() + 32;
+        }
+
+        char* write_text(char* out, const std::string_view text) {
+            std::memcpy(out, text.data(), text.size());
+            return out + text.size();
+        }
+
+        char* write_number(char* out, const int64_t value) {
+            return std::to_chars(out, out + 24, value).ptr;
+        }
+
+        char* write_number(char* out, const double value) {
+#if defined(__cpp_lib_to_chars)
+            return std::to_chars(out, out + 32, value).ptr;
+#else
+            return out + std::snprintf(out, 32, "%.17g", value);
+#endif
+        }
+
+        constexpr uint64_t ones = 0x0101010101010101ULL;
+        constexpr uint64_t highs = 0x8080808080808080ULL;
+
+        /**
+         * Returns the position of the first byte at or after `from` that must be escaped,
+         * or `size` when there is none. Checks 8 bytes at a time: the lowest flagged byte
+         * of a word is always a real match, later ones may not be.
+         */
+        size_t find_escape(const char* data, size_t from, const size_t size) {
+            for (; from + 8 <= size; from += 8) {
+                uint64_t word;
+                std::memcpy(&word, data + from, 8);
+                const uint64_t quotes = word ^ (ones * '"');
+                const uint64_t backslashes = word ^ (ones * '\\');
+                const uint64_t hits = ((word - ones * 0x20) | (quotes - ones) | (backslashes - ones))
+                                      & ~word & highs;
+                // bytes with the high bit set never need escaping, so ~word rules them out
+                if (hits != 0) {
+#if defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                    return from + __builtin_ctzll(hits) / 8;
+#else
+                    break;
+#endif
+                }
+            }
+            for (; from < size; from++) {
+                if (json_escapes.escapes[static_cast<unsigned char>(data[from])] != 0) {
+                    return from;
+                }
+            }
+            return size;
+        }
+
+        /**
+         * Writes `text` as a quoted JSON string.
+         */
+        char* write_string(char* out, const std::string_view text) {
+            *out++ = '"';
+
+            size_t start = 0;
+            for (size_t i = find_escape(text.data(), 0, text.size()); i < text.size();
+                 i = find_escape(text.data(), start, text.size())) {
+                const unsigned char c = static_cast<unsigned char>(text[i]);
+                const char escape = json_escapes.escapes[c];
+
+                out = write_text(out, text.substr(start, i - start));
+                *out++ = '\\';
+                *out++ = escape;
+                if (escape == 'u') {
+                    static const char hex[] = "0123456789abcdef";
+                    *out++ = '0';
+                    *out++ = '0';
+                    *out++ = hex[c >> 4];
+                    *out++ = hex[c & 15];
+                }
+                start = i + 1;
+            }
+
+            out = write_text(out, text.substr(start));
+            *out++ = '"';
+            return out;
+        }
+
+        /**
+         * A file opened for writing, closed when it goes out of scope.
+         */
+        class output_file {
+
+        private:
+            int fd;
+
+        public:
+            explicit output_file(const std::string& path) {
+#if defined(_WIN32)
+                fd = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+                fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+                if (fd < 0) {
+                    throw std::runtime_error("Unable to create file: " + path);
+                }
+            }
+
+            ~output_file() {
+#if defined(_WIN32)
+                _close(fd);
+#else
+                ::close(fd);
+#endif
+            }
+
+            output_file(const output_file&) = delete;
+            output_file& operator=(const output_file&) = delete;
+
+            int get() const {
+                return fd;
+            }
+
+        };
+
+    }
+
+    csv_json_writer::csv_json_writer(const int fd, const size_t flush_size) : fd(fd), flush_size(flush_size) {
+        buffer.resize(flush_size);
+    }
+
+    csv_json_writer::~csv_json_writer() {
+        try {
+            flush();
+        } catch (...) {
+            // destructors must not throw; call flush() to see write errors
+        }
+    }
+
+    void csv_json_writer::set_keys(const std::vector<std::string_view>& names) {
+        keys.clear();
+        for (const std::string_view name : names) {
+            std::string key(value_bound(name), '\0');
+            char* end = write_string(&key[0], name);
+            *end++ = ':';
+            key.resize(end - key.data());
+            keys.push_back(std::move(key));
+        }
+    }
+
+    void csv_json_writer::set_keys(const csv_header& header) {
+        std::vector<std::string_view> names;
+        for (size_t i = 0; i < header.size(); i++) {
+            names.emplace_back(header.name(i));
+        }
+        set_keys(names);
+    }
+
+    void csv_json_writer::set_types(std::vector<csv_type> types) {
+        this->types = std::move(types);
+    }
+
+    char* csv_json_writer::write_key(char* out, const size_t column) const {
+        if (column < keys.size()) {
+            return write_text(out, keys[column]);
+        }
+        *out++ = '"';
+        out = write_number(out, static_cast<int64_t>(column));
+        *out++ = '"';
+        *out++ = ':';
+        return out;
+    }
+
+    char* csv_json_writer::write_value(char* out, const size_t column, const std::string_view field) const {
+        const csv_type type = column < types.size() ? types[column] : csv_type::utf8;
+        if (type == csv_type::utf8 || type == csv_type::timestamp) {
+            return write_string(out, field);
+        }
+        if (field.empty()) {
+            return write_text(out, "null");
+        }
+
+        switch (type) {
+            case csv_type::int64: {
+                int64_t value;
+                if (parse_int64(field, value)) {
+                    return is_json_number(field) ? write_text(out, field) : write_number(out, value);
+                }
+                break;
+            }
+            case csv_type::float64: {
+                double value;
+                if (parse_double(field, value)) {
+                    if (!std::isfinite(value)) {
+                        // JSON has no infinities or NaN
+                        return write_text(out, "null");
+                    }
+                    return is_json_number(field) ? write_text(out, field) : write_number(out, value);
+                }
+                break;
+            }
+            case csv_type::boolean: {
+                bool value;
+                if (parse_bool(field, value)) {
+                    return write_text(out, value ? "true" : "false");
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        return write_string(out, field);
+    }
+
+    template <typename Field>
+    void csv_json_writer::write_fields(const size_t count, Field field) {
+        // room for the worst case, so fields are written without bounds checks, plus the
+        // null byte that ends the data
+        size_t bound = 4;
+        for (size_t i = 0; i < count; i++) {
+            bound += (i < keys.size() ? keys[i].size() : 24) + value_bound(field(i));
+        }
+
+        // the buffer only grows, so its bytes are not cleared again for every record
+        if (buffer.size() < used + bound) {
+            buffer.resize(std::max(used + bound, 2 * buffer.size()));
+        }
+        char* out = buffer.data() + used;
+
+        *out++ = '{';
+        for (size_t i = 0; i < count; i++) {
+            if (i > 0) {
+                *out++ = ',';
+            }
+            out = write_key(out, i);
+            out = write_value(out, i, field(i));
+        }
+        *out++ = '}';
+        *out++ = '\n';
+        *out = '\0';
+
+        used = out - buffer.data();
+        records++;
+
+        if (fd >= 0 && used >= flush_size) {
+            flush();
+        }
+    }
+
+    void csv_json_writer::write_row(const csv_parser& record) {
+        write_fields(record.size(), [&](const size_t i) { return record.view(i); });
+    }
+
+    void csv_json_writer::write_row(const std::vector<std::string_view>& row) {
+        write_fields(row.size(), [&](const size_t i) { return row[i]; });
+    }
+
+    void csv_json_writer::flush() {
+        if (fd < 0) {
+            return;
+        }
+
+        size_t written = 0;
+        while (written < used) {
+#if defined(_WIN32)
+            const int result = _write(fd, buffer.data() + written, static_cast<unsigned>(used - written));
+#else
+            const ssize_t result = ::write(fd, buffer.data() + written, used - written);
+#endif
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::memmove(buffer.data(), buffer.data() + written, used - written);
+                used -= written;
+                throw std::runtime_error(std::string("Unable to write json data: ") + std::strerror(errno));
+            }
+            written += static_cast<size_t>(result);
+        }
+        used = 0;
+    }
+
+    std::string_view csv_json_writer::data() const {
+        return std::string_view(used > 0 ? buffer.data() : "", used);
+    }
+
+    size_t csv_json_writer::rows() const {
+        return records;
+    }
+
+    void csv_json_writer::clear() {
+        used = 0;
+        records = 0;
+    }
+
+    size_t csv_to_json_lines(const std::string& input, const std::string& output, const csv_dialect& dialect,
+                             const bool typed) {
+        std::error_code ignored;
+        if (std::filesystem::equivalent(input, output, ignored)) {
+            throw std::invalid_argument("The output cannot be the input file: " + output);
+        }
+
+        csv_reader reader;
+        reader.open(input, dialect);
+
+        output_file file(output);
+        csv_json_writer writer(file.get());
+        if (dialect.header) {
+            writer.set_keys(reader.record().get_header());
+        }
+        if (typed) {
+            writer.set_types(csv_schema_inferrer().infer_file(input, dialect).types());
+        }
+
+        while (reader.next()) {
+            writer.write_row(reader.record());
+        }
+
+        writer.flush();
+        return writer.rows();
+    }
+
+}
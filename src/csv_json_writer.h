@@ -0,0 +1,136 @@
+//
+// Created by Andres Jaimes on 16/10/25.
+//
+
+#ifndef CSV_JSON_WRITER_H
+#define CSV_JSON_WRITER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "csv_header.h"
+#include "csv_parser.h"
+#include "csv_sniffer.h"
+#include "csv_types.h"
+
+namespace sevilla {
+
+    /**
+     * Writes csv records as JSON Lines, one object per record, into a growable buffer or a
+     * file descriptor. Keys are escaped once, when they are set, and fields are escaped
+     * straight into the buffer, copying the runs between escapes in bulk. Bytes are copied
+     * as they are, so the input should be UTF-8.
+     *
+     * Without types every value is a string. With them, numbers and booleans are written
+     * bare, and empty fields as null. Fields that do not parse as their column type, and
+     * timestamps, stay strings.
+     */
+    class csv_json_writer {
+
+    private:
+        /**
+         * Records are written at the start of `buffer`, `used` bytes of it, followed by a
+         * null byte.
+         */
+        std::vector<char> buffer;
+        size_t used = 0;
+
+        /**
+         * Every key, escaped and quoted, with its colon.
+         */
+        std::vector<std::string> keys;
+
+        std::vector<csv_type> types;
+
+        /**
+         * Destination descriptor, or -1 when records stay in `buffer`.
+         */
+        int fd = -1;
+
+        size_t flush_size = 64 * 1024;
+        size_t records = 0;
+
+        char* write_key(char* out, size_t column) const;
+        char* write_value(char* out, size_t column, std::string_view field) const;
+
+        /**
+         * Writes a record of `count` fields, where `field(i)` returns field `i`.
+         */
+        template <typename Field>
+        void write_fields(size_t count, Field field);
+
+    public:
+        csv_json_writer() = default;
+
+        /**
+         * Writes records to `fd`, which stays owned by the caller. Bytes are buffered and
+         * written once `flush_size` of them have accumulated, and when the writer is flushed
+         * or destroyed.
+         */
+        explicit csv_json_writer(int fd, size_t flush_size = 64 * 1024);
+
+        ~csv_json_writer();
+
+        csv_json_writer(const csv_json_writer&) = delete;
+        csv_json_writer& operator=(const csv_json_writer&) = delete;
+
+        /**
+         * Sets the key of every column. Columns without a key use their number, from 0.
+         */
+        void set_keys(const std::vector<std::string_view>& names);
+        void set_keys(const csv_header& header);
+
+        /**
+         * Sets the type of every column, like `csv_schema::types`. Columns without a type
+         * are strings.
+         */
+        void set_types(std::vector<csv_type> types);
+
+        /**
+         * Appends the fields of the last record parsed by `record`, as one line.
+         */
+        void write_row(const csv_parser& record);
+
+        /**
+         * Appends a record, as one line.
+         */
+        void write_row(const std::vector<std::string_view>& row);
+
+        /**
+         * Writes the buffered bytes to the file descriptor. Throws std::runtime_error when
+         * the write fails. Does nothing when writing to a buffer.
+         */
+        void flush();
+
+        /**
+         * Returns the buffered bytes, which are followed by a null byte. When writing to a
+         * file descriptor, only the bytes that were not flushed yet.
+         */
+        std::string_view data() const;
+
+        /**
+         * Returns the number of records written since the writer was created or cleared.
+         */
+        size_t rows() const;
+
+        /**
+         * Drops the buffered bytes and the row count, keeping the allocated memory.
+         */
+        void clear();
+
+    };
+
+    /**
+     * Converts the csv file at `input`, which may be gzip-compressed, into a JSON Lines file
+     * at `output`, reading it through `csv_reader` in constant memory. With a header, its
+     * names are the keys. With `typed`, column types are inferred first from a sample of
+     * the file, see `csv_schema_inferrer`. Returns the number of records written. Throws
+     * std::runtime_error when a file cannot be read or written, and std::invalid_argument
+     * when `output` is `input`.
+     */
+    size_t csv_to_json_lines(const std::string& input, const std::string& output, const csv_dialect& dialect = {},
+                             bool typed = false);
+
+}
+
+#endif //CSV_JSON_WRITER_H
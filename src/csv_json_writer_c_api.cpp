@@ -0,0 +1,92 @@
+//
+// Created by Andres Jaimes on 16/10/25.
+//
+
+#include "c_api.h"
+#include "csv_json_writer.h"
+#include "csv_reader.h"
+#include "csv_schema.h"
+#include "json.hpp"
+
+thread_local sevilla::csv_json_writer json_lines_writer;
+
+namespace {
+
+    sevilla::csv_dialect make_dialect(const char separator, const int header) {
+        sevilla::csv_dialect dialect;
+        dialect.separator = separator;
+        dialect.header = header != 0;
+        return dialect;
+    }
+
+}
+
+/**
+ * Converts csv data into JSON Lines, one object per record, and returns the text, writing
+ * its size to `length`. With `header`, the first record names the keys; without it, keys
+ * are column numbers. With `typed`, numbers and booleans are written bare, after inferring
+ * the column types from a sample. The text stays valid until the next call on the same
+ * thread. Returns null on failure.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_to_json_lines(const char* data, const size_t size, const char separator, const int header,
+                                 const int typed, size_t* length) {
+    if (length != nullptr) {
+        *length = 0;
+    }
+    if (data == nullptr && size > 0) {
+        return nullptr;
+    }
+
+    try {
+        const sevilla::csv_dialect dialect = make_dialect(separator, header);
+        sevilla::csv_reader reader;
+        reader.open(data, size, dialect);
+
+        json_lines_writer.clear();
+        json_lines_writer.set_keys(reader.record().get_header());
+        json_lines_writer.set_types(typed != 0
+                                    ? sevilla::csv_schema_inferrer().infer(data, size, dialect).types()
+                                    : std::vector<sevilla::csv_type>());
+
+        while (reader.next()) {
+            json_lines_writer.write_row(reader.record());
+        }
+
+        const std::string_view text = json_lines_writer.data();
+        if (length != nullptr) {
+            *length = text.size();
+        }
+        return text.data();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+/**
+ * Like sv_csv_to_json_lines, converting the csv file at `input`, which may be
+ * gzip-compressed, into the file at `output`. Returns a json object with the number of
+ * `rows` written, or with an `error`.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_to_json_lines_file(const char* input, const char* output, const char separator, const int header,
+                                      const int typed) {
+    thread_local std::string result;
+
+    if (input == nullptr || output == nullptr) {
+        result = make_error("No file given");
+        return result.c_str();
+    }
+
+    try {
+        nlohmann::json j;
+        j["rows"] = sevilla::csv_to_json_lines(input, output, make_dialect(separator, header), typed != 0);
+        result = j.dump();
+    } catch (std::exception& e) {
+        result = make_error(e.what());
+    } catch (...) {
+        result = make_error("Unknown exception");
+    }
+
+    return result.c_str();
+}
@@ -2,57 +2,453 @@
 // Created by Andres Jaimes on 25/06/25.
 //
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
 #include "csv_parser.h"
+#include "csv_types.h"
 
 namespace sevilla {
 
-    size_t csv_parser::parse_line(const std::string &line, const char separator) {
-        fields.clear();
-        std::string field;
+    csv_parser::csv_parser(const csv_scanner::engine engine) : scanner(engine) {}
+
+    csv_parser::csv_parser(const csv_parser& other)
+        : scanner(other.scanner), quote(other.quote), views(other.views), retain(other.retain),
+          line_buffer(other.line_buffer), owns_line(other.owns_line), complete(other.complete),
+          fields(other.fields), materialized(other.materialized), selection(other.selection),
+          slots(other.slots), header(other.header), filters(other.filters), passed(other.passed) {
+        for (std::string_view& view : views) {
+            if (other.arena.contains(view.data())) {
+                // unescaped fields are followed by a terminator, which is copied with them
+                char* copy = arena.allocate(view.size() + 1);
+                std::memcpy(copy, view.data(), view.size() + 1);
+                view = std::string_view(copy, view.size());
+            }
+        }
+        rebase_views(other.line_buffer.data(), other.line_buffer.size());
+    }
+
+    csv_parser::csv_parser(csv_parser&& other) noexcept
+        : scanner(std::move(other.scanner)), quote(other.quote), views(std::move(other.views)),
+          arena(std::move(other.arena)), retain(other.retain), owns_line(other.owns_line),
+          complete(other.complete), fields(std::move(other.fields)), materialized(other.materialized),
+          selection(std::move(other.selection)), slots(std::move(other.slots)),
+          header(std::move(other.header)), filters(std::move(other.filters)), passed(other.passed) {
+        // a short line lives inside the string itself, so it moves to a new address
+        const char* line = other.line_buffer.data();
+        const size_t size = other.line_buffer.size();
+        line_buffer = std::move(other.line_buffer);
+        rebase_views(line, size);
+
+        other.views.clear();
+        other.fields.clear();
+        other.materialized = false;
+        other.owns_line = false;
+    }
+
+    csv_parser& csv_parser::operator=(const csv_parser& other) {
+        if (this != &other) {
+            *this = csv_parser(other);
+        }
+        return *this;
+    }
+
+    csv_parser& csv_parser::operator=(csv_parser&& other) noexcept {
+        if (this != &other) {
+            scanner = std::move(other.scanner);
+            quote = other.quote;
+            views = std::move(other.views);
+            arena = std::move(other.arena);
+            retain = other.retain;
+            owns_line = other.owns_line;
+            complete = other.complete;
+            fields = std::move(other.fields);
+            materialized = other.materialized;
+            selection = std::move(other.selection);
+            slots = std::move(other.slots);
+            header = std::move(other.header);
+            filters = std::move(other.filters);
+            passed = other.passed;
+
+            const char* line = other.line_buffer.data();
+            const size_t size = other.line_buffer.size();
+            line_buffer = std::move(other.line_buffer);
+            rebase_views(line, size);
+
+            other.views.clear();
+            other.fields.clear();
+            other.materialized = false;
+            other.owns_line = false;
+        }
+        return *this;
+    }
+
+    void csv_parser::rebase_views(const char* line, const size_t size) {
+        if (!owns_line) {
+            return;
+        }
+        // the terminator after the last field is part of the line too
+        const std::less_equal<const char*> not_after;
+        for (std::string_view& view : views) {
+            if (not_after(line, view.data()) && not_after(view.data(), line + size)) {
+                view = std::string_view(line_buffer.data() + (view.data() - line), view.size());
+            }
+        }
+    }
+
+    size_t csv_parser::parse_line(const std::string_view line, const char separator) {
+        line_buffer.assign(line);
+        parse_line_view(line_buffer, separator);
+        owns_line = true;
+
+        // terminate every field in place, so they can be handed out as c strings.
+        // the byte after a field is a separator, a quote, or the string's terminator
+        // when it points into line_buffer, and a reserved terminator when it points into the arena.
+        for (const std::string_view& view : views) {
+            const_cast<char*>(view.data())[view.size()] = '\0';
+        }
+
+        return views.size();
+    }
+
+    size_t csv_parser::parse_line_view(const std::string_view line, const char separator) {
+        parse(line, separator, false);
+        return views.size();
+    }
+
+    size_t csv_parser::parse_record(const std::string_view data, const char separator) {
+        return parse(data, separator, true);
+    }
+
+    bool csv_parser::terminated() const {
+        return complete;
+    }
+
+    size_t csv_parser::parse(const std::string_view data, const char separator, const bool line_breaks) {
+        views.clear();
+        materialized = false;
+        owns_line = false;
+        passed = true;
+
+        if (!retain) {
+            arena.reset();
+        }
+
+        // the scanner reports every quote, and the separators found outside quotes
+        bool in_quotes = false;
+        size_t count = scanner.scan(data.data(), data.size(), separator, quote, line_breaks, in_quotes);
+        const size_t* offsets = scanner.offsets();
+
+        // a record ends at its first line feed outside quotes, which the scanner reports last
+        size_t end = data.size();
+        size_t consumed = data.size();
+        complete = false;
+
+        if (line_breaks && count > 0 && data[offsets[count - 1]] == '\n' && !in_quotes) {
+            end = offsets[count - 1];
+            consumed = end + 1;
+            complete = true;
+            count--;
+        }
+        if (line_breaks && !in_quotes && end > 0 && data[end - 1] == '\r') {
+            end--;
+        }
+
+        if (!filters.empty() && !matches(data, offsets, count, end)) {
+            passed = false;
+            return consumed;
+        }
+
+        // with a projection, fields start out empty, as spans at the end of the data,
+        // and columns past the last selected one are not looked at.
+        if (!slots.empty()) {
+            views.assign(selection.size(), data.substr(data.size()));
+        }
+
+        size_t start = 0;
+        size_t column = 0;
+        bool quoted = false;
+
+        for (size_t k = 0; k < count; k++) {
+            const size_t i = offsets[k];
+            if (i >= end) {
+                break;
+            }
+            if (data[i] == quote) {
+                quoted = true;
+            } else {
+                add_field(data.substr(start, i - start), quoted, column++);
+                start = i + 1;
+                quoted = false;
+                if (!slots.empty() && column >= slots.size()) {
+                    return consumed;
+                }
+            }
+        }
+
+        add_field(data.substr(start, end - start), quoted, column);
+        return consumed;
+    }
+
+    bool csv_parser::matches(const std::string_view data, const size_t* offsets, const size_t count,
+                             const size_t end) {
+        size_t last_column = 0;
+        for (const csv_predicate& predicate : filters) {
+            last_column = std::max(last_column, predicate.column);
+        }
+
+        // fields decoded here are dropped from the arena once tested
+        const csv_arena::mark reserved = arena.position();
+        size_t start = 0;
+        size_t column = 0;
+        size_t k = 0;
+
+        while (true) {
+            size_t stop = end;
+            bool quoted = false;
+            for (; k < count && offsets[k] < end; k++) {
+                if (data[offsets[k]] == quote) {
+                    quoted = true;
+                } else {
+                    stop = offsets[k++];
+                    break;
+                }
+            }
+
+            const std::string_view raw = data.substr(start, stop - start);
+            for (const csv_predicate& predicate : filters) {
+                if (predicate.column == column && !predicate.test(decode(raw, quoted))) {
+                    arena.rewind(reserved);
+                    return false;
+                }
+            }
+            arena.rewind(reserved);
+
+            if (stop == end || column == last_column) {
+                break;
+            }
+            start = stop + 1;
+            column++;
+        }
+
+        // columns missing from the record are empty
+        for (const csv_predicate& predicate : filters) {
+            if (predicate.column > column && !predicate.test({})) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void csv_parser::add_field(const std::string_view raw, const bool quoted, const size_t column) {
+        if (slots.empty()) {
+            views.push_back(decode(raw, quoted));
+        } else if (column < slots.size() && slots[column] >= 0) {
+            views[slots[column]] = decode(raw, quoted);
+        }
+    }
+
+    std::string_view csv_parser::decode(const std::string_view raw, const bool quoted) {
+        if (!quoted) {
+            return raw;
+        }
+
+        // a fully quoted field without escapes is just a span without its quotes
+        if (raw.size() >= 2 && raw.front() == quote && raw.back() == quote && raw.find(quote, 1) == raw.size() - 1) {
+            return raw.substr(1, raw.size() - 2);
+        }
+
+        // unescaping never grows a field; one more byte terminates it
+        char* const begin = arena.allocate(raw.size() + 1);
+        char* out = begin;
         bool in_quotes = false;
 
-        for (size_t i = 0; i < line.size(); i++) {
-            const char c = line[i];
+        for (size_t i = 0; i < raw.size(); i++) {
+            const char c = raw[i];
             if (in_quotes) {
-                if (c == '"') {
-                    if (i + 1 < line.size() && line[i + 1] == '"') {
-                        field += '"';
+                if (c == quote) {
+                    if (i + 1 < raw.size() && raw[i + 1] == quote) {
+                        *out++ = quote;
                         i++;
                     } else {
                         in_quotes = false;
                     }
                 } else {
-                    field += c;
+                    *out++ = c;
                 }
             } else {
-                if (c == '"') {
+                if (c == quote) {
                     in_quotes = true;
-                } else if (c == separator) {
-                    fields.push_back(field);
-                    field.clear();
                 } else {
-                    field += c;
+                    *out++ = c;
                 }
             }
         }
 
-        fields.push_back(field);
-        return fields.size();
+        *out = '\0';
+        return {begin, static_cast<size_t>(out - begin)};
+    }
+
+    void csv_parser::materialize() const {
+        fields.resize(views.size());
+        for (size_t i = 0; i < views.size(); i++) {
+            fields[i].assign(views[i]);
+        }
+        materialized = true;
     }
 
     const std::string& csv_parser::operator[](const size_t index) const {
-        if (index >= fields.size()) {
+        if (index >= views.size()) {
             throw std::out_of_range("Index is out of range");
         }
+        if (!materialized) {
+            materialize();
+        }
         return fields[index];
     }
 
+    std::string_view csv_parser::view(const size_t index) const {
+        if (index >= views.size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        return views[index];
+    }
+
+    const char* csv_parser::c_str(const size_t index) const {
+        if (owns_line) {
+            return view(index).data();
+        }
+        return (*this)[index].c_str();
+    }
+
+    const std::string& csv_parser::operator[](const std::string_view name) const {
+        return (*this)[column(name)];
+    }
+
+    std::string_view csv_parser::view(const std::string_view name) const {
+        return view(column(name));
+    }
+
+    void csv_parser::set_header(const csv_header& names) {
+        header = names;
+    }
+
+    void csv_parser::set_header() {
+        header = csv_header(views);
+    }
+
+    const csv_header& csv_parser::get_header() const {
+        return header;
+    }
+
+    size_t csv_parser::column(const std::string_view name) const {
+        const size_t index = header.find(name);
+        if (index == csv_header::npos) {
+            throw std::out_of_range("Column not found in header: " + std::string(name));
+        }
+        return index;
+    }
+
+    void csv_parser::select(const std::vector<size_t>& columns) {
+        std::vector<int32_t> mapping;
+        for (size_t i = 0; i < columns.size(); i++) {
+            if (columns[i] >= mapping.size()) {
+                mapping.resize(columns[i] + 1, -1);
+            }
+            if (mapping[columns[i]] >= 0) {
+                throw std::invalid_argument("Column is selected more than once");
+            }
+            mapping[columns[i]] = static_cast<int32_t>(i);
+        }
+        slots = std::move(mapping);
+        selection = columns;
+    }
+
+    const std::vector<size_t>& csv_parser::selected() const {
+        return selection;
+    }
+
+    void csv_parser::set_quote(const char value) {
+        quote = value;
+    }
+
+    char csv_parser::get_quote() const {
+        return quote;
+    }
+
+    void csv_parser::add_filter(const csv_predicate& predicate) {
+        filters.push_back(predicate);
+    }
+
+    void csv_parser::clear_filters() {
+        filters.clear();
+    }
+
+    const std::vector<csv_predicate>& csv_parser::get_filters() const {
+        return filters;
+    }
+
+    bool csv_parser::accepted() const {
+        return passed;
+    }
+
+    void csv_parser::retain_fields(const bool value) {
+        retain = value;
+    }
+
+    void csv_parser::release_fields() {
+        arena.reset();
+    }
+
+    void csv_parser::resize(const size_t count) {
+        views.resize(count);
+        materialized = false;
+    }
+
+    int64_t csv_parser::get_int64(const size_t index) const {
+        int64_t value;
+        if (!parse_int64(view(index), value)) {
+            throw std::invalid_argument("Field is not an integer");
+        }
+        return value;
+    }
+
+    double csv_parser::get_double(const size_t index) const {
+        double value;
+        if (!parse_double(view(index), value)) {
+            throw std::invalid_argument("Field is not a number");
+        }
+        return value;
+    }
+
+    bool csv_parser::get_bool(const size_t index) const {
+        bool value;
+        if (!parse_bool(view(index), value)) {
+            throw std::invalid_argument("Field is not a boolean");
+        }
+        return value;
+    }
+
+    int64_t csv_parser::get_timestamp(const size_t index) const {
+        int64_t value;
+        if (!parse_timestamp(view(index), value)) {
+            throw std::invalid_argument("Field is not a date or timestamp");
+        }
+        return value;
+    }
+
     size_t csv_parser::size() const {
-        return fields.size();
+        return views.size();
     }
 
     void csv_parser::reset() {
+        views.clear();
+        arena.reset();
         fields.clear();
+        materialized = false;
+        owns_line = false;
+        passed = true;
     }
 
 }
@@ -5,34 +5,257 @@
 #ifndef CSV_PARSER_H
 #define CSV_PARSER_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "csv_arena.h"
+#include "csv_header.h"
+#include "csv_predicate.h"
+#include "csv_scanner.h"
 
 namespace sevilla {
 
     class csv_parser {
 
     private:
-        std::vector<std::string> fields;
+        csv_scanner scanner;
+        char quote = '"';
+
+        /**
+         * Field spans for the last parsed line. They point into the parsed line, or into
+         * `arena` for fields that had to be unescaped.
+         */
+        std::vector<std::string_view> views;
+
+        /**
+         * Backing storage for unescaped fields, reset before every record unless fields
+         * are retained.
+         */
+        csv_arena arena;
+        bool retain = false;
+
+        /**
+         * Private copy of the line, used by `parse_line`.
+         */
+        std::string line_buffer;
+
+        /**
+         * Whether the views point into `line_buffer`.
+         */
+        bool owns_line = false;
+
+        /**
+         * Whether the last parsed record ended with a line break.
+         */
+        bool complete = false;
+
+        /**
+         * `std::string` copies of the fields, only built when `operator[]` is used.
+         */
+        mutable std::vector<std::string> fields;
+        mutable bool materialized = false;
+
+        /**
+         * Selected columns, in output order, and for each column of the input its position
+         * in the output, or -1 when it is skipped. Both are empty without a projection.
+         */
+        std::vector<size_t> selection;
+        std::vector<int32_t> slots;
+
+        /**
+         * Column names, for lookups by name. Kept across records and resets.
+         */
+        csv_header header;
+
+        /**
+         * Row filters, all of which must match, and whether the last record matched them.
+         */
+        std::vector<csv_predicate> filters;
+        bool passed = true;
+
+        size_t parse(std::string_view data, char separator, bool line_breaks);
+
+        bool matches(std::string_view data, const size_t* offsets, size_t count, size_t end);
+
+        void add_field(std::string_view raw, bool quoted, size_t column);
+
+        std::string_view decode(std::string_view raw, bool quoted);
+
+        void materialize() const;
+
+        /**
+         * Points the views that pointed into `line`, which held `size` bytes, into
+         * `line_buffer`, once the line was copied or moved there.
+         */
+        void rebase_views(const char* line, size_t size);
 
     public:
+        csv_parser() = default;
+
+        /**
+         * Copies and moves keep the last record: its fields point into the new parser's
+         * own copy of the line and of the unescaped fields, or into the caller's data.
+         */
+        csv_parser(const csv_parser& other);
+        csv_parser(csv_parser&& other) noexcept;
+        csv_parser& operator=(const csv_parser& other);
+        csv_parser& operator=(csv_parser&& other) noexcept;
+
+        /**
+         * Uses a specific scanning engine instead of the fastest one available.
+         */
+        explicit csv_parser(csv_scanner::engine engine);
+
         /**
          * Parses a csv line. Fields may contain internal quotes.
+         * The line is copied, so it does not need to outlive the parser.
          */
-        size_t parse_line(const std::string& line, char separator);
+        size_t parse_line(std::string_view line, char separator);
+
+        /**
+         * Parses a csv line without copying it. Fields are returned as spans into `line`,
+         * so `line` must outlive any access to them. Only fields with escaped quotes are
+         * copied, into an arena that is reused across calls.
+         */
+        size_t parse_line_view(std::string_view line, char separator);
+
+        /**
+         * Parses the first record in `data`, without copying it. A record ends at the first
+         * line feed outside quotes, so quoted fields may contain line breaks. A trailing
+         * carriage return is dropped. Returns the number of bytes consumed, including the
+         * line break.
+         */
+        size_t parse_record(std::string_view data, char separator);
+
+        /**
+         * Returns whether the last record parsed by `parse_record` ended with a line break.
+         * When it did not, the record ran up to the end of the data.
+         */
+        bool terminated() const;
 
         /**
          * Returns a field by index.
          */
         const std::string& operator[](size_t index) const;
 
+        /**
+         * Returns a field by index, without copying it.
+         */
+        std::string_view view(size_t index) const;
+
+        /**
+         * Returns a field by index as a null-terminated string.
+         */
+        const char* c_str(size_t index) const;
+
+        /**
+         * Returns a field by column name. Throws std::out_of_range when the header has no
+         * such column, or the record is shorter than the header.
+         */
+        const std::string& operator[](std::string_view name) const;
+
+        /**
+         * Returns a field by column name, without copying it.
+         */
+        std::string_view view(std::string_view name) const;
+
+        /**
+         * Sets the names used by lookups by name. Names map to field positions, so with a
+         * projection they follow the selected order.
+         */
+        void set_header(const csv_header& names);
+
+        /**
+         * Uses the fields of the last parsed record as the header.
+         */
+        void set_header();
+
+        const csv_header& get_header() const;
+
+        /**
+         * Returns the index of a named column, so hot loops can resolve a name once and
+         * then index by position. Throws std::out_of_range when the header has no such column.
+         */
+        size_t column(std::string_view name) const;
+
+        /**
+         * Keeps only the given columns, in the given order. Other fields are skipped without
+         * being unescaped or stored, and fields are then indexed by their position in `columns`.
+         * Columns missing from a line come back empty. An empty list keeps every column.
+         */
+        void select(const std::vector<size_t>& columns);
+
+        /**
+         * Returns the selected columns, or an empty list when every column is kept.
+         */
+        const std::vector<size_t>& selected() const;
+
+        /**
+         * Sets the character that encloses fields. Defaults to a double quote.
+         * Quotes inside fields are escaped by doubling them.
+         */
+        void set_quote(char value);
+
+        char get_quote() const;
+
+        /**
+         * Adds a row filter. Records that fail any filter are dropped as soon as the fields
+         * the filters look at are found: they come back with no fields, and `accepted`
+         * returns false. Parsing calls still return the bytes the record took.
+         */
+        void add_filter(const csv_predicate& predicate);
+
+        void clear_filters();
+
+        const std::vector<csv_predicate>& get_filters() const;
+
+        /**
+         * Returns whether the last parsed record passed every filter.
+         */
+        bool accepted() const;
+
+        /**
+         * Pads the last parsed record with empty fields, or drops its last fields, so it has
+         * `count` fields.
+         */
+        void resize(size_t count);
+
+        /**
+         * Keeps the unescaped fields of every record parsed from now on, so spans taken
+         * from earlier records of a batch stay valid, until `release_fields` is called.
+         * By default they are only valid until the next record is parsed. Either way, the
+         * memory is reused, and parsing allocates nothing once the arena has grown to fit
+         * a record or a batch.
+         */
+        void retain_fields(bool value);
+
+        /**
+         * Gives back the memory of retained fields, ending a batch.
+         */
+        void release_fields();
+
+        /**
+         * Typed accessors. They parse the field's bytes without copying them, and throw
+         * std::invalid_argument when the field does not hold a value of the type.
+         * See csv_types.h for the accepted formats.
+         */
+        int64_t get_int64(size_t index) const;
+        double get_double(size_t index) const;
+        bool get_bool(size_t index) const;
+
+        /**
+         * Returns an ISO 8601 date or date-time field as microseconds since the Unix epoch.
+         */
+        int64_t get_timestamp(size_t index) const;
+
         /**
          * Returns the number of fields found in the last parsed line.
          */
         size_t size() const;
 
         /**
-         * Resets the class's inner state.
+         * Resets the class's inner state. The projection, the header and the filters are kept.
          */
         void reset();
 
@@ -2,16 +2,40 @@
 // Created by Andres Jaimes on 25/06/25.
 //
 
-#include <locale>
-#include <codecvt>
+#include "basic_csv_parser.h"
 #include "c_api.h"
+#include "csv_handler.h"
 #include "csv_parser.h"
+#include "csv_table.h"
+#include "csv_types.h"
+#include "utils.h"
 
 thread_local sevilla::csv_parser csv_parser;
+thread_local sevilla::csv_table csv_batch;
+thread_local size_t csv_batch_consumed = 0;
+
+/**
+ * Utf-8 conversion of the last wide line, reused across lines, and every field of the last
+ * line converted back, each followed by a null, with where each one starts.
+ * The wide fields are built once per line, on the first sv_csv_field_w call.
+ */
+thread_local std::string csv_line_utf8;
+thread_local std::wstring csv_wide_fields;
+thread_local std::vector<size_t> csv_wide_offsets;
+thread_local bool csv_wide_ready = false;
+
+namespace {
+
+    void reset_parser() {
+        csv_parser.reset();
+        csv_wide_ready = false;
+    }
+
+}
 
 extern "C" DLL_EXPORT
 size_t sv_parse_csv_line(const char* line, const char separator) {
-    csv_parser.reset();
+    reset_parser();
 
     if (line == nullptr) {
         return 0;
@@ -20,29 +44,81 @@ size_t sv_parse_csv_line(const char* line, const char separator) {
     return csv_parser.parse_line(line, separator);
 }
 
+/**
+ * Parses a wide line. The line is converted to utf-8 once, into a buffer reused across calls,
+ * and parsed like a narrow line, so sv_csv_field returns its fields without copying them.
+ */
 extern "C" DLL_EXPORT
 size_t sv_parse_csv_line_w(const wchar_t* line, const wchar_t separator) {
-    csv_parser.reset();
+    reset_parser();
 
-    if (line == nullptr) {
+    // separators must be a single utf-8 byte
+    if (line == nullptr || static_cast<unsigned long>(separator) > 127) {
+        return 0;
+    }
+
+    try {
+        csv_line_utf8.clear();
+        sevilla::wide_to_utf8(line, csv_line_utf8);
+        return csv_parser.parse_line(csv_line_utf8, static_cast<char>(separator));
+    } catch (...) {
+        reset_parser();
         return 0;
     }
+}
 
-    // utf-8/utf-16 converter
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+/**
+ * Sets the character that encloses fields for the next lines, as detected by sv_csv_sniff.
+ */
+extern "C" DLL_EXPORT
+void sv_csv_set_quote(const char quote) {
+    csv_parser.set_quote(quote);
+}
 
+/**
+ * Keeps only `count` columns for the next lines, in the given order. A count of 0 keeps every column.
+ * Returns 1 on success, and 0 when a column is repeated.
+ */
+extern "C" DLL_EXPORT
+int sv_csv_select(const size_t* columns, size_t count) {
     try {
-        const std::wstring ws_line = std::wstring(line);
-        // convert to std::string assuming utf-8
-        const std::string u8_line = converter.to_bytes(ws_line);
-        // do a simple conversion for the separator, since we expect ASCII
-        const char sep = separator <= 127 ? static_cast<char>(separator) : ',';
-        return sv_parse_csv_line(u8_line.c_str(), sep);
+        if (columns == nullptr || count == 0) {
+            csv_parser.select({});
+        } else {
+            csv_parser.select(std::vector<size_t>(columns, columns + count));
+        }
+        return 1;
     } catch (...) {
         return 0;
     }
 }
 
+/*
+ * Row filters. Lines and batch records that fail any of them are dropped before their
+ * fields are stored: sv_parse_csv_line returns 0 for them, and batches leave them out.
+ * Columns are positions in the input, before sv_csv_select.
+ */
+
+extern "C" DLL_EXPORT
+void sv_csv_filter_equals(size_t column, const char* value) {
+    csv_parser.add_filter(sevilla::csv_predicate::equals(column, value != nullptr ? value : ""));
+}
+
+extern "C" DLL_EXPORT
+void sv_csv_filter_prefix(size_t column, const char* value) {
+    csv_parser.add_filter(sevilla::csv_predicate::prefix(column, value != nullptr ? value : ""));
+}
+
+extern "C" DLL_EXPORT
+void sv_csv_filter_range(size_t column, double min, double max) {
+    csv_parser.add_filter(sevilla::csv_predicate::range(column, min, max));
+}
+
+extern "C" DLL_EXPORT
+void sv_csv_clear_filters() {
+    csv_parser.clear_filters();
+}
+
 extern "C" DLL_EXPORT
 size_t sv_csv_field_count() {
     return csv_parser.size();
@@ -51,23 +127,300 @@ size_t sv_csv_field_count() {
 extern "C" DLL_EXPORT
 const char* sv_csv_field(size_t index) {
     try {
-        return csv_parser[index].c_str();
+        return csv_parser.c_str(index);
     } catch (...) {
         return nullptr;
     }
 }
 
+/**
+ * Parses a header line, whose names are then used by sv_csv_field_by_name for the next lines.
+ * Names follow the columns kept by sv_csv_select. Returns the number of names.
+ */
 extern "C" DLL_EXPORT
-const wchar_t* sv_csv_field_w(size_t index) {
-    thread_local std::wstring converted;
+size_t sv_csv_set_header(const char* line, const char separator) {
+    reset_parser();
+
+    if (line == nullptr) {
+        csv_parser.set_header(sevilla::csv_header());
+        return 0;
+    }
+
+    try {
+        // the header is never filtered out
+        const std::vector<sevilla::csv_predicate> filters = csv_parser.get_filters();
+        csv_parser.clear_filters();
+        csv_parser.parse_line_view(line, separator);
+        csv_parser.set_header();
+        reset_parser();
+        for (const sevilla::csv_predicate& predicate : filters) {
+            csv_parser.add_filter(predicate);
+        }
+        return csv_parser.get_header().size();
+    } catch (...) {
+        return 0;
+    }
+}
+
+/**
+ * Returns a field of the last line by column name, or null when the header has no such
+ * column or the line is shorter than the header.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_field_by_name(const char* name) {
+    if (name == nullptr) {
+        return nullptr;
+    }
+
+    const size_t index = csv_parser.get_header().find(name);
+    if (index == sevilla::csv_header::npos) {
+        return nullptr;
+    }
+    return sv_csv_field(index);
+}
 
-    // utf-8/utf-16 converter
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+/**
+ * Returns a field of the last line as a wide string. The first call after a line is parsed
+ * converts all of its fields at once, and later calls return spans of that conversion.
+ */
+extern "C" DLL_EXPORT
+const wchar_t* sv_csv_field_w(size_t index) {
+    if (index >= csv_parser.size()) {
+        return nullptr;
+    }
 
     try {
-        converted = converter.from_bytes(csv_parser[index]);
-        return converted.c_str();
+        if (!csv_wide_ready) {
+            csv_wide_fields.clear();
+            csv_wide_offsets.clear();
+            for (size_t i = 0; i < csv_parser.size(); i++) {
+                csv_wide_offsets.push_back(csv_wide_fields.size());
+                sevilla::utf8_to_wide(csv_parser.view(i), csv_wide_fields);
+                csv_wide_fields += L'\0';
+            }
+            csv_wide_ready = true;
+        }
+        return csv_wide_fields.data() + csv_wide_offsets[index];
     } catch (...) {
         return nullptr;
     }
 }
+
+/*
+ * Typed field accessors. They return 1 and write `value` when the field holds a value of
+ * the type, and 0 otherwise, so host languages skip the string round-trip per cell.
+ */
+
+extern "C" DLL_EXPORT
+int sv_csv_field_int64(size_t index, int64_t* value) {
+    if (value == nullptr || index >= csv_parser.size()) {
+        return 0;
+    }
+    return sevilla::parse_int64(csv_parser.view(index), *value) ? 1 : 0;
+}
+
+extern "C" DLL_EXPORT
+int sv_csv_field_double(size_t index, double* value) {
+    if (value == nullptr || index >= csv_parser.size()) {
+        return 0;
+    }
+    return sevilla::parse_double(csv_parser.view(index), *value) ? 1 : 0;
+}
+
+extern "C" DLL_EXPORT
+int sv_csv_field_bool(size_t index, int* value) {
+    bool result;
+    if (value == nullptr || index >= csv_parser.size() || !sevilla::parse_bool(csv_parser.view(index), result)) {
+        return 0;
+    }
+    *value = result ? 1 : 0;
+    return 1;
+}
+
+extern "C" DLL_EXPORT
+int sv_csv_field_timestamp(size_t index, int64_t* value) {
+    if (value == nullptr || index >= csv_parser.size()) {
+        return 0;
+    }
+    return sevilla::parse_timestamp(csv_parser.view(index), *value) ? 1 : 0;
+}
+
+/*
+ * Batch parsing. One call parses many records into a flat, library-owned result that stays
+ * valid until the next batch on the same thread:
+ * - the bytes of every field, one after the other (sv_csv_batch_data),
+ * - fields + 1 offsets into those bytes (sv_csv_batch_field_offsets),
+ * - rows + 1 offsets into the field table (sv_csv_batch_row_offsets).
+ * Field i of row r is field number row_offsets[r] + i.
+ */
+
+namespace {
+
+    /**
+     * Fills the batch with a parser whose separator is fixed at compile time.
+     */
+    template <char Separator>
+    void parse_batch_as(const char* data, const size_t size, const size_t max_rows) {
+        thread_local sevilla::basic_csv_parser<Separator> parser;
+
+        while (csv_batch_consumed < size && (max_rows == 0 || csv_batch.rows() < max_rows)) {
+            const std::string_view rest(data + csv_batch_consumed, size - csv_batch_consumed);
+            csv_batch_consumed += parser.parse_record(rest);
+            csv_batch.append(parser.views());
+        }
+        parser.reset();
+    }
+
+}
+
+/**
+ * Parses up to `max_rows` records from `data`, or every record when `max_rows` is 0.
+ * Quoted fields may contain line breaks, and a final record without a line break is included.
+ * Returns the number of rows parsed. sv_csv_batch_consumed tells where to resume.
+ */
+extern "C" DLL_EXPORT
+size_t sv_parse_csv_batch(const char* data, size_t size, const char separator, size_t max_rows) {
+    csv_batch.clear();
+    csv_batch_consumed = 0;
+
+    if (data == nullptr) {
+        return 0;
+    }
+
+    // common dialects go to a specialized parser, chosen once per batch, unless the
+    // batch needs a projection, filters or a custom quote
+    const bool plain = csv_parser.selected().empty() && csv_parser.get_filters().empty() &&
+                       csv_parser.get_quote() == '"';
+
+    try {
+        switch (plain ? separator : '\0') {
+            case ',':
+                parse_batch_as<','>(data, size, max_rows);
+                break;
+            case '\t':
+                parse_batch_as<'\t'>(data, size, max_rows);
+                break;
+            case ';':
+                parse_batch_as<';'>(data, size, max_rows);
+                break;
+            case '|':
+                parse_batch_as<'|'>(data, size, max_rows);
+                break;
+            default:
+                while (csv_batch_consumed < size && (max_rows == 0 || csv_batch.rows() < max_rows)) {
+                    const std::string_view rest(data + csv_batch_consumed, size - csv_batch_consumed);
+                    csv_batch_consumed += csv_parser.parse_record(rest, separator);
+                    if (csv_parser.accepted()) {
+                        csv_batch.append(csv_parser);
+                    }
+                }
+                reset_parser();
+                break;
+        }
+        return csv_batch.rows();
+    } catch (...) {
+        csv_batch.clear();
+        csv_batch_consumed = 0;
+        reset_parser();
+        return 0;
+    }
+}
+
+/**
+ * Returns the number of bytes the last batch consumed.
+ */
+extern "C" DLL_EXPORT
+size_t sv_csv_batch_consumed() {
+    return csv_batch_consumed;
+}
+
+/**
+ * Returns the field bytes of the last batch, writing their size to `length`.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_batch_data(size_t* length) {
+    if (length != nullptr) {
+        *length = csv_batch.data().size();
+    }
+    return csv_batch.data().data();
+}
+
+/**
+ * Returns the field offsets of the last batch, writing the number of fields to `count`.
+ */
+extern "C" DLL_EXPORT
+const size_t* sv_csv_batch_field_offsets(size_t* count) {
+    if (count != nullptr) {
+        *count = csv_batch.fields().size() - 1;
+    }
+    return csv_batch.fields().data();
+}
+
+/**
+ * Returns the row offsets of the last batch: one more than the number of rows.
+ */
+extern "C" DLL_EXPORT
+const size_t* sv_csv_batch_row_offsets() {
+    return csv_batch.row_fields().data();
+}
+
+/*
+ * Event parsing. Fields are passed to callbacks as they are found, without being stored:
+ * `data` points into the input, or into a reused unescape buffer, is not null-terminated
+ * and is only valid during the call.
+ */
+
+typedef void (*sv_csv_field_callback)(size_t row, size_t column, const char* data, size_t size, void* user_data);
+typedef void (*sv_csv_row_callback)(size_t row, void* user_data);
+
+namespace {
+
+    class callback_handler : public sevilla::csv_handler {
+
+    private:
+        sv_csv_field_callback field_callback;
+        sv_csv_row_callback row_callback;
+        void* user_data;
+
+    public:
+        callback_handler(sv_csv_field_callback on_field, sv_csv_row_callback on_row_end, void* user_data)
+            : field_callback(on_field), row_callback(on_row_end), user_data(user_data) {}
+
+        void on_field(const size_t row, const size_t column, const char* data, const size_t size) override {
+            if (field_callback != nullptr) {
+                field_callback(row, column, data, size, user_data);
+            }
+        }
+
+        void on_row_end(const size_t row) override {
+            if (row_callback != nullptr) {
+                row_callback(row, user_data);
+            }
+        }
+
+    };
+
+}
+
+/**
+ * Parses every record of `data`, calling `on_field` for each field and `on_row_end` after
+ * each record. Either callback may be null. The projection, filters and quote set on this
+ * thread apply. Returns the number of rows passed to the callbacks.
+ */
+extern "C" DLL_EXPORT
+size_t sv_parse_csv_events(const char* data, size_t size, const char separator, sv_csv_field_callback on_field,
+                           sv_csv_row_callback on_row_end, void* user_data) {
+    reset_parser();
+
+    if (data == nullptr) {
+        return 0;
+    }
+
+    try {
+        callback_handler handler(on_field, on_row_end, user_data);
+        return sevilla::parse_csv(csv_parser, std::string_view(data, size), separator, handler);
+    } catch (...) {
+        reset_parser();
+        return 0;
+    }
+}
@@ -0,0 +1,49 @@
+//
+// Created by Andres Jaimes on 23/08/25.
+//
+
+#include "csv_predicate.h"
+#include "csv_types.h"
+
+namespace sevilla {
+
+    csv_predicate csv_predicate::equals(const size_t column, const std::string_view value) {
+        csv_predicate predicate;
+        predicate.op = kind::equals;
+        predicate.column = column;
+        predicate.text = value;
+        return predicate;
+    }
+
+    csv_predicate csv_predicate::prefix(const size_t column, const std::string_view value) {
+        csv_predicate predicate;
+        predicate.op = kind::prefix;
+        predicate.column = column;
+        predicate.text = value;
+        return predicate;
+    }
+
+    csv_predicate csv_predicate::range(const size_t column, const double min, const double max) {
+        csv_predicate predicate;
+        predicate.op = kind::range;
+        predicate.column = column;
+        predicate.min = min;
+        predicate.max = max;
+        return predicate;
+    }
+
+    bool csv_predicate::test(const std::string_view field) const {
+        switch (op) {
+            case kind::equals:
+                return field == text;
+            case kind::prefix:
+                return field.substr(0, text.size()) == text;
+            case kind::range: {
+                double value;
+                return parse_double(field, value) && value >= min && value <= max;
+            }
+        }
+        return false;
+    }
+
+}
@@ -0,0 +1,52 @@
+//
+// Created by Andres Jaimes on 23/08/25.
+//
+
+#ifndef CSV_PREDICATE_H
+#define CSV_PREDICATE_H
+
+#include <string>
+#include <string_view>
+
+namespace sevilla {
+
+    /**
+     * A test on one field of a record, evaluated by the parser on the unescaped field before
+     * any other field is stored. Columns are positions in the input, before any projection.
+     */
+    struct csv_predicate {
+
+        enum class kind {
+            equals,
+            prefix,
+            range
+        };
+
+        kind op = kind::equals;
+        size_t column = 0;
+        std::string text;
+        double min = 0;
+        double max = 0;
+
+        /**
+         * Matches fields equal to `value`.
+         */
+        static csv_predicate equals(size_t column, std::string_view value);
+
+        /**
+         * Matches fields that start with `value`.
+         */
+        static csv_predicate prefix(size_t column, std::string_view value);
+
+        /**
+         * Matches numeric fields within `[min, max]`. Fields that are not numbers never match.
+         */
+        static csv_predicate range(size_t column, double min, double max);
+
+        bool test(std::string_view field) const;
+
+    };
+
+}
+
+#endif //CSV_PREDICATE_H
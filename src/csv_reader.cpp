@@ -0,0 +1,493 @@
+//
+// Created by Andres Jaimes on 12/07/25.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include "csv_reader.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sevilla {
+
+    namespace {
+
+        /**
+         * Records end at line feeds only, which also covers "\r\n".
+         */
+        void check_line_break(const csv_dialect& dialect) {
+            if (dialect.line_break != "\n" && dialect.line_break != "\r\n") {
+                throw std::invalid_argument("Unsupported line break, records must end with \\n or \\r\\n");
+            }
+        }
+
+    }
+
+    csv_reader::~csv_reader() {
+        close();
+    }
+
+    void csv_reader::open(const std::string& path, const char separator) {
+        close();
+
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Unable to open file: " + path);
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size)) {
+            CloseHandle(file);
+            throw std::runtime_error("Unable to read file size: " + path);
+        }
+
+        // empty files cannot be mapped
+        if (file_size.QuadPart > 0) {
+            HANDLE handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            void* view = handle != nullptr ? MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            // the view keeps the mapping alive after its handles are closed
+            if (handle != nullptr) {
+                CloseHandle(handle);
+            }
+            if (view == nullptr) {
+                CloseHandle(file);
+                throw std::runtime_error("Unable to map file: " + path);
+            }
+            mapping = view;
+            mapping_size = static_cast<size_t>(file_size.QuadPart);
+        }
+        CloseHandle(file);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Unable to open file: " + path);
+        }
+
+        struct stat info {};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Unable to read file size: " + path);
+        }
+
+        // empty files cannot be mapped
+        if (info.st_size > 0) {
+            void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Unable to map file: " + path);
+            }
+            madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            mapping = view;
+            mapping_size = static_cast<size_t>(info.st_size);
+        }
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+#endif
+
+        open(static_cast<const char*>(mapping), mapping_size, separator);
+    }
+
+    void csv_reader::open(const std::string& path, const csv_dialect& dialect) {
+        check_line_break(dialect);
+        open(path, dialect.separator);
+        start(dialect);
+    }
+
+    void csv_reader::open(const char* data, const size_t size, const csv_dialect& dialect) {
+        check_line_break(dialect);
+        open(data, size, dialect.separator);
+        start(dialect);
+    }
+
+    void csv_reader::start(const csv_dialect& dialect) {
+        parser.set_quote(dialect.quote);
+        // compressed input has nothing in the window until its first chunk arrives
+        if (dialect.header && (position < length || refill())) {
+            read_header();
+        }
+    }
+
+    void csv_reader::open(const char* data, const size_t size, const char separator) {
+        inflater.reset();
+        window.clear();
+        window_offset = 0;
+
+        this->data = data;
+        this->length = data != nullptr ? size : 0;
+        this->separator = separator;
+        position = 0;
+        record_offset = 0;
+        rows = 0;
+        width = 0;
+        counts = {};
+        parser.reset();
+        parser.set_quote('"');
+
+        if (csv_inflater::is_gzip(data, size)) {
+            inflater = std::make_unique<csv_inflater>(data, size);
+            this->data = window.data();
+            this->length = 0;
+        }
+    }
+
+    bool csv_reader::refill() {
+        if (inflater == nullptr || !inflater->next(chunk)) {
+            return false;
+        }
+
+        window.erase(0, position);
+        window_offset += position;
+        window += chunk;
+        position = 0;
+        data = window.data();
+        length = window.size();
+        return true;
+    }
+
+    void csv_reader::close() {
+        // the inflater reads from the mapping
+        inflater.reset();
+        window.clear();
+        window_offset = 0;
+
+        if (mapping != nullptr) {
+#if defined(_WIN32)
+            UnmapViewOfFile(mapping);
+#else
+            munmap(mapping, mapping_size);
+#endif
+            mapping = nullptr;
+            mapping_size = 0;
+        }
+        data = nullptr;
+        length = 0;
+        position = 0;
+        parser.reset();
+    }
+
+    bool csv_reader::next() {
+        // records rejected by a filter are skipped, but still counted
+        while (true) {
+            if (position >= length && !refill()) {
+                parser.reset();
+                return false;
+            }
+
+            const size_t consumed = parser.parse_record(std::string_view(data + position, length - position), separator);
+            // a record cut by the end of the window may continue in the next chunk
+            if (!parser.terminated() && refill()) {
+                continue;
+            }
+
+            const std::string_view raw(data + position, consumed);
+            record_offset = window_offset + position;
+            position += consumed;
+            rows++;
+            if (policy != csv_error_policy::lenient && !check(raw)) {
+                continue;
+            }
+            if (parser.accepted()) {
+                return true;
+            }
+        }
+    }
+
+    bool csv_reader::check(const std::string_view raw) {
+        size_t fields;
+        csv_error error;
+        if (validator.check(raw, separator, parser.get_quote(), fields, error)) {
+            if (width == 0) {
+                width = fields;
+            }
+            if (fields == width) {
+                return true;
+            }
+            error.kind = csv_error_kind::ragged_row;
+            error.offset = 0;
+            error.column = std::min(fields, width);
+        }
+
+        error.offset += record_offset;
+        error.row = rows - 1;
+        last = error;
+        switch (error.kind) {
+            case csv_error_kind::unterminated_quote: counts.unterminated_quotes++; break;
+            case csv_error_kind::stray_quote: counts.stray_quotes++; break;
+            case csv_error_kind::ragged_row: counts.ragged_rows++; break;
+        }
+
+        switch (policy) {
+            case csv_error_policy::abort:
+                throw csv_format_error(error);
+            case csv_error_policy::skip:
+                counts.skipped_rows++;
+                return false;
+            default:
+                // with a projection, missing columns already come back empty
+                if (error.kind == csv_error_kind::ragged_row && parser.selected().empty() && parser.accepted()) {
+                    parser.resize(width);
+                }
+                return true;
+        }
+    }
+
+    void csv_reader::set_error_policy(const csv_error_policy policy) {
+        this->policy = policy;
+    }
+
+    csv_error_policy csv_reader::get_error_policy() const {
+        return policy;
+    }
+
+    const csv_error_counts& csv_reader::errors() const {
+        return counts;
+    }
+
+    const csv_error& csv_reader::last_error() const {
+        return last;
+    }
+
+    csv_index csv_reader::build_index(const size_t stride) const {
+        if (inflater != nullptr) {
+            throw std::runtime_error("Compressed input cannot be indexed");
+        }
+        csv_index index(stride);
+        index.build(data, length, parser.get_quote());
+        return index;
+    }
+
+    void csv_reader::seek(const csv_index& index, const size_t row) {
+        if (inflater != nullptr) {
+            throw std::runtime_error("Compressed input cannot be seeked");
+        }
+        if (index.size() != length) {
+            throw std::invalid_argument("The index was built for different data");
+        }
+        parser.reset();
+
+        if (row == index.rows()) {
+            position = length;
+            rows = row;
+            return;
+        }
+
+        position = index.checkpoint(row);
+        for (size_t skip = row % index.get_stride(); skip > 0; skip--) {
+            position += parser.parse_record(std::string_view(data + position, length - position), separator);
+        }
+        parser.reset();
+        rows = row;
+    }
+
+    void csv_reader::seek(const size_t offset) {
+        if (inflater != nullptr) {
+            throw std::runtime_error("Compressed input cannot be seeked");
+        }
+        if (offset > length) {
+            throw std::out_of_range("Offset is past the end of the data");
+        }
+        parser.reset();
+
+        const void* line_break = std::memchr(data + offset, '\n', length - offset);
+        position = line_break != nullptr ? static_cast<const char*>(line_break) - data + 1 : length;
+    }
+
+    bool csv_reader::compressed() const {
+        return inflater != nullptr;
+    }
+
+    void csv_reader::select(const std::vector<size_t>& columns) {
+        parser.select(columns);
+    }
+
+    void csv_reader::add_filter(const csv_predicate& predicate) {
+        parser.add_filter(predicate);
+    }
+
+    void csv_reader::clear_filters() {
+        parser.clear_filters();
+    }
+
+    void csv_reader::read_header() {
+        // the header is never filtered out
+        const std::vector<csv_predicate> filters = parser.get_filters();
+        parser.clear_filters();
+        const bool found = next();
+        for (const csv_predicate& predicate : filters) {
+            parser.add_filter(predicate);
+        }
+
+        if (!found) {
+            throw std::invalid_argument("There is no header to read");
+        }
+        parser.set_header();
+    }
+
+    void csv_reader::select(const std::vector<std::string>& names) {
+        parser.select({});
+        read_header();
+
+        std::vector<size_t> columns;
+        for (const std::string& name : names) {
+            const size_t index = parser.get_header().find(name);
+            if (index == csv_header::npos) {
+                throw std::invalid_argument("Column not found in header: " + name);
+            }
+            columns.push_back(index);
+        }
+        parser.select(columns);
+        parser.set_header(csv_header(std::vector<std::string_view>(names.begin(), names.end())));
+    }
+
+    std::vector<csv_table> csv_reader::read_parallel(size_t threads) {
+        // inflated data only arrives in order, so it is parsed as it comes, and checked
+        // records need the row numbers and widths of all the records before them
+        if (inflater != nullptr || policy != csv_error_policy::lenient) {
+            std::vector<csv_table> tables(1);
+            while (next()) {
+                tables[0].append(parser);
+            }
+            return tables;
+        }
+
+        // small inputs are not worth more than a thread per 64 KB
+        constexpr size_t min_chunk = 64 * 1024;
+        const size_t remaining = length - position;
+
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::max<size_t>(1, std::min(threads, remaining / min_chunk));
+
+        const char* base = data + position;
+        const size_t chunk = remaining / threads;
+
+        const char quote = parser.get_quote();
+
+        // pass one: count the quotes in every range, so the quoted state at each split
+        // point is known from the parity of all the quotes before it.
+        std::vector<size_t> quotes(threads, 0);
+        std::vector<std::thread> workers;
+        std::vector<std::exception_ptr> errors(threads);
+
+        for (size_t t = 1; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                const char* begin = base + (t - 1) * chunk;
+                quotes[t] = static_cast<size_t>(std::count(begin, begin + chunk, quote));
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+
+        // move every split point past the first line feed outside quotes
+        std::vector<size_t> bounds(threads + 1, remaining);
+        bounds[0] = 0;
+        bool in_quotes = false;
+        csv_scanner scanner;
+
+        for (size_t t = 1; t < threads; t++) {
+            in_quotes = in_quotes != (quotes[t] % 2 == 1);
+            const size_t split = t * chunk;
+            bool quoted = in_quotes;
+            const size_t count = scanner.scan(base + split, remaining - split, separator, quote, true, quoted);
+            const size_t* offsets = scanner.offsets();
+
+            if (count > 0 && base[split + offsets[count - 1]] == '\n' && !quoted) {
+                bounds[t] = std::max(bounds[t - 1], split + offsets[count - 1] + 1);
+            } else {
+                bounds[t] = remaining;
+            }
+        }
+
+        // pass two: parse every range on its own thread
+        std::vector<csv_table> tables(threads);
+        std::vector<size_t> scanned(threads, 0);
+
+        for (size_t t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                try {
+                    csv_parser local;
+                    local.select(parser.selected());
+                    local.set_quote(quote);
+                    for (const csv_predicate& predicate : parser.get_filters()) {
+                        local.add_filter(predicate);
+                    }
+                    size_t offset = bounds[t];
+                    while (offset < bounds[t + 1]) {
+                        offset += local.parse_record(std::string_view(base + offset, bounds[t + 1] - offset), separator);
+                        scanned[t]++;
+                        if (local.accepted()) {
+                            tables[t].append(local);
+                        }
+                    }
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // like next(), rows counts the records filtered out too
+        for (const size_t count : scanned) {
+            rows += count;
+        }
+        position = length;
+        parser.reset();
+
+        return tables;
+    }
+
+    const std::string& csv_reader::operator[](const size_t index) const {
+        return parser[index];
+    }
+
+    std::string_view csv_reader::view(const size_t index) const {
+        return parser.view(index);
+    }
+
+    const std::string& csv_reader::operator[](const std::string_view name) const {
+        return parser[name];
+    }
+
+    std::string_view csv_reader::view(const std::string_view name) const {
+        return parser.view(name);
+    }
+
+    size_t csv_reader::size() const {
+        return parser.size();
+    }
+
+    const csv_parser& csv_reader::record() const {
+        return parser;
+    }
+
+    size_t csv_reader::row() const {
+        return rows;
+    }
+
+    size_t csv_reader::offset() const {
+        return record_offset;
+    }
+
+}
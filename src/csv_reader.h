@@ -0,0 +1,248 @@
+//
+// Created by Andres Jaimes on 12/07/25.
+//
+
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "csv_error.h"
+#include "csv_index.h"
+#include "csv_inflater.h"
+#include "csv_parser.h"
+#include "csv_sniffer.h"
+#include "csv_table.h"
+
+namespace sevilla {
+
+    /**
+     * Iterates over the records of a memory-mapped csv file. Records are parsed in place,
+     * so the file is never copied, and quoted fields may contain line breaks.
+     * Gzip-compressed input is detected and inflated on a separate thread while it is
+     * parsed, through a window that only holds the current chunk and any record it cuts.
+     */
+    class csv_reader {
+
+    private:
+        csv_parser parser;
+        char separator = ',';
+
+        const char* data = nullptr;
+        size_t length = 0;
+        size_t position = 0;
+        size_t record_offset = 0;
+        size_t rows = 0;
+
+        void* mapping = nullptr;
+        size_t mapping_size = 0;
+
+        /**
+         * For compressed input: the inflater, the window of inflated bytes that `data`
+         * points to, and how many inflated bytes came before the window.
+         */
+        std::unique_ptr<csv_inflater> inflater;
+        std::string window;
+        std::string chunk;
+        size_t window_offset = 0;
+
+        /**
+         * Replaces the consumed part of the window with the next inflated chunk.
+         * Returns false when the input is not compressed or has no more chunks.
+         */
+        bool refill();
+
+        /**
+         * Strict mode: how malformed records are handled, the fields every record must have,
+         * or 0 until a well-formed record sets it, and what was found.
+         */
+        csv_error_policy policy = csv_error_policy::lenient;
+        csv_validator validator;
+        size_t width = 0;
+        csv_error_counts counts;
+        csv_error last;
+
+        /**
+         * Checks the raw bytes of the current record, applying the policy. Returns false when
+         * the record is left out.
+         */
+        bool check(std::string_view raw);
+
+        /**
+         * Sets the quote of `dialect`, and reads the header when it has one.
+         */
+        void start(const csv_dialect& dialect);
+
+    public:
+        csv_reader() = default;
+        ~csv_reader();
+
+        csv_reader(const csv_reader&) = delete;
+        csv_reader& operator=(const csv_reader&) = delete;
+
+        /**
+         * Maps a file into memory. Throws if the file cannot be opened or mapped.
+         */
+        void open(const std::string& path, char separator);
+
+        /**
+         * Maps a file written in `dialect`, reading its header when it has one.
+         * See `csv_sniffer::sniff_file`. Throws std::invalid_argument when its line break
+         * is "\r", which the reader does not support.
+         */
+        void open(const std::string& path, const csv_dialect& dialect);
+
+        /**
+         * Reads from a buffer owned by the caller, which must outlive the reader.
+         * Fields are enclosed in double quotes.
+         */
+        void open(const char* data, size_t size, char separator);
+
+        /**
+         * Reads from a buffer written in `dialect`, reading its header when it has one.
+         * Throws std::invalid_argument when its line break is "\r".
+         */
+        void open(const char* data, size_t size, const csv_dialect& dialect);
+
+        /**
+         * Releases the mapped file.
+         */
+        void close();
+
+        /**
+         * Moves to the next record that passes the filters. Returns false when there are
+         * no more records.
+         */
+        bool next();
+
+        /**
+         * Indexes every `stride`th record of the open data, from its start.
+         * Throws std::runtime_error for compressed input.
+         */
+        csv_index build_index(size_t stride = 1024) const;
+
+        /**
+         * Moves to just before record `row`, counted from the start of the data, so the next
+         * call to `next` reads it. Jumps to the closest checkpoint of `index` and parses at
+         * most `stride - 1` records from there. Throws std::invalid_argument when the index
+         * was built for data of another size, std::out_of_range when `row` is past the end,
+         * and std::runtime_error for compressed input.
+         */
+        void seek(const csv_index& index, size_t row);
+
+        /**
+         * Moves to the first line that starts after byte `offset`, so the next call to `next`
+         * reads it. Without an index the record boundary is a guess, as the line may start
+         * inside a quoted field, and row numbers keep counting from where they were.
+         * Throws std::out_of_range when `offset` is past the end, and std::runtime_error
+         * for compressed input.
+         */
+        void seek(size_t offset);
+
+        /**
+         * Returns whether the open data is gzip-compressed.
+         */
+        bool compressed() const;
+
+        /**
+         * Keeps only the given columns, in the given order. See `csv_parser::select`.
+         */
+        void select(const std::vector<size_t>& columns);
+
+        /**
+         * Skips the records that fail `predicate`, before their fields are stored.
+         * See `csv_parser::add_filter`.
+         */
+        void add_filter(const csv_predicate& predicate);
+
+        void clear_filters();
+
+        /**
+         * Reads the next record as the header, for lookups by name. Throws std::invalid_argument
+         * when there are no more records.
+         */
+        void read_header();
+
+        /**
+         * Reads the next record as the header, and keeps only the named columns, in the given
+         * order. Names then refer to the selected columns. Throws if a name is not in the header.
+         */
+        void select(const std::vector<std::string>& names);
+
+        /**
+         * Checks every record from now on, and handles the malformed ones as `policy` says.
+         * Records must all have as many fields as the first well-formed one, usually the
+         * header. With `csv_error_policy::abort`, `next` throws csv_format_error and the
+         * reader is left after the malformed record, so reading can resume.
+         */
+        void set_error_policy(csv_error_policy policy);
+
+        csv_error_policy get_error_policy() const;
+
+        /**
+         * Returns how many malformed records were found since the data was opened.
+         */
+        const csv_error_counts& errors() const;
+
+        /**
+         * Returns the last error found. Only meaningful when `errors().total()` is not zero.
+         */
+        const csv_error& last_error() const;
+
+        /**
+         * Parses every remaining record across `threads` worker threads, or one per core when
+         * `threads` is 0. The data is split into byte ranges that are moved to the next record
+         * boundary, even when a split lands inside a quoted field. Returns one table per range,
+         * in file order. Compressed input is parsed into a single table, as it is inflated,
+         * and so is any input while records are checked. See `set_error_policy`.
+         */
+        std::vector<csv_table> read_parallel(size_t threads = 0);
+
+        /**
+         * Returns a field of the current record by index.
+         */
+        const std::string& operator[](size_t index) const;
+
+        /**
+         * Returns a field of the current record by index, without copying it.
+         */
+        std::string_view view(size_t index) const;
+
+        /**
+         * Returns a field of the current record by column name. See `read_header`.
+         */
+        const std::string& operator[](std::string_view name) const;
+
+        /**
+         * Returns a field of the current record by column name, without copying it.
+         */
+        std::string_view view(std::string_view name) const;
+
+        /**
+         * Returns the number of fields in the current record.
+         */
+        size_t size() const;
+
+        /**
+         * Returns the parser holding the current record.
+         */
+        const csv_parser& record() const;
+
+        /**
+         * Returns the number of records read so far, including the ones filtered out.
+         */
+        size_t row() const;
+
+        /**
+         * Returns the byte offset where the current record starts. For compressed input,
+         * the offset into the inflated data.
+         */
+        size_t offset() const;
+
+    };
+
+}
+
+#endif //CSV_READER_H
@@ -0,0 +1,356 @@
+//
+// Created by Andres Jaimes on 05/07/25.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "csv_scanner.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define SEVILLA_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define SEVILLA_AVX2
+    #include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace sevilla {
+
+    namespace {
+
+        inline int trailing_zeros(const uint64_t x) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, x);
+            return static_cast<int>(index);
+#else
+            return __builtin_ctzll(x);
+#endif
+        }
+
+        /**
+         * Sets every bit that has an odd number of set bits at or below it.
+         * Applied to a quote mask, it marks the bytes that are inside quotes.
+         */
+        inline uint64_t prefix_xor(uint64_t x) {
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+        }
+
+        /**
+         * Appends the offset of every set bit in `mask`. A block adds at most 64 offsets.
+         */
+        inline void emit(uint64_t mask, const size_t base, std::vector<size_t>& indexes, size_t& count) {
+            if (indexes.size() < count + 64) {
+                indexes.resize(indexes.size() * 2 + 64);
+            }
+            while (mask != 0) {
+                indexes[count++] = base + trailing_zeros(mask);
+                mask &= mask - 1;
+            }
+        }
+
+        size_t scan_scalar(const char* data, const size_t size, const char separator, const char quote,
+                           const bool line_breaks, bool& in_quotes, std::vector<size_t>& indexes) {
+            size_t count = 0;
+
+            for (size_t i = 0; i < size; i++) {
+                const char c = data[i];
+                if (c == quote) {
+                    in_quotes = !in_quotes;
+                } else if (in_quotes || (c != separator && (!line_breaks || c != '\n'))) {
+                    continue;
+                }
+
+                if (indexes.size() <= count) {
+                    indexes.resize(indexes.size() * 2 + 64);
+                }
+                indexes[count++] = i;
+
+                if (c == '\n' && line_breaks && !in_quotes) {
+                    break;
+                }
+            }
+
+            return count;
+        }
+
+        size_t find_scalar(const char* data, const size_t size, const char separator, const char quote) {
+            for (size_t i = 0; i < size; i++) {
+                const char c = data[i];
+                if (c == separator || c == quote || c == '\r' || c == '\n') {
+                    return i;
+                }
+            }
+            return size;
+        }
+
+        /**
+         * Shared block loop for the vector engines. `Loader` turns 64 bytes into
+         * quote, separator and line feed bit masks.
+         */
+        template <class Loader>
+        size_t scan_blocks(const char* data, const size_t size, const char separator, const char quote,
+                           const bool line_breaks, bool& in_quotes, std::vector<size_t>& indexes) {
+            const Loader loader(separator, quote);
+            uint64_t carry = in_quotes ? ~0ULL : 0;
+            size_t count = 0;
+
+            for (size_t offset = 0; offset < size; offset += 64) {
+                uint64_t quotes, separators, breaks;
+                const size_t remaining = size - offset;
+
+                if (remaining >= 64) {
+                    loader.load(data + offset, quotes, separators, breaks);
+                } else {
+                    char tail[64] = {};
+                    std::memcpy(tail, data + offset, remaining);
+                    loader.load(tail, quotes, separators, breaks);
+                    const uint64_t valid = (1ULL << remaining) - 1;
+                    quotes &= valid;
+                    separators &= valid;
+                    breaks &= valid;
+                }
+
+                const uint64_t inside = prefix_xor(quotes) ^ carry;
+                uint64_t structural = (separators & ~inside) | quotes;
+
+                if (line_breaks) {
+                    const uint64_t outside_breaks = breaks & ~inside;
+                    if (outside_breaks != 0) {
+                        const uint64_t first = outside_breaks & (~outside_breaks + 1);
+                        emit((structural & (first - 1)) | first, offset, indexes, count);
+                        in_quotes = false;
+                        return count;
+                    }
+                }
+
+                emit(structural, offset, indexes, count);
+                carry = static_cast<uint64_t>(static_cast<int64_t>(inside) >> 63);
+            }
+
+            in_quotes = carry != 0;
+            return count;
+        }
+
+#ifdef SEVILLA_SSE2
+        struct sse2_loader {
+            __m128i quote;
+            __m128i separator;
+            __m128i line_feed;
+
+            sse2_loader(const char s, const char q)
+                : quote(_mm_set1_epi8(q)), separator(_mm_set1_epi8(s)), line_feed(_mm_set1_epi8('\n')) {}
+
+            static uint64_t mask(const __m128i* chunks, const __m128i value) {
+                const uint64_t m0 = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[0], value)));
+                const uint64_t m1 = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[1], value)));
+                const uint64_t m2 = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[2], value)));
+                const uint64_t m3 = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[3], value)));
+                return m0 | (m1 << 16) | (m2 << 32) | (m3 << 48);
+            }
+
+            void load(const char* p, uint64_t& quotes, uint64_t& separators, uint64_t& breaks) const {
+                const __m128i chunks[4] = {
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)),
+                };
+                quotes = mask(chunks, quote);
+                separators = mask(chunks, separator);
+                breaks = mask(chunks, line_feed);
+            }
+        };
+
+        size_t scan_sse2(const char* data, const size_t size, const char separator, const char quote,
+                         const bool line_breaks, bool& in_quotes, std::vector<size_t>& indexes) {
+            return scan_blocks<sse2_loader>(data, size, separator, quote, line_breaks, in_quotes, indexes);
+        }
+
+        size_t find_sse2(const char* data, const size_t size, const char separator, const char quote) {
+            const __m128i s = _mm_set1_epi8(separator);
+            const __m128i q = _mm_set1_epi8(quote);
+            const __m128i cr = _mm_set1_epi8('\r');
+            const __m128i lf = _mm_set1_epi8('\n');
+            size_t i = 0;
+
+            for (; i + 16 <= size; i += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                const __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, s), _mm_cmpeq_epi8(v, q)),
+                                                  _mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf)));
+                const int mask = _mm_movemask_epi8(hits);
+                if (mask != 0) {
+                    return i + trailing_zeros(static_cast<uint64_t>(mask));
+                }
+            }
+
+            return i + find_scalar(data + i, size - i, separator, quote);
+        }
+#endif
+
+#ifdef SEVILLA_AVX2
+        struct avx2_loader {
+            char quote;
+            char separator;
+
+            avx2_loader(const char s, const char q) : quote(q), separator(s) {}
+
+            __attribute__((target("avx2")))
+            static uint64_t mask(const __m256i lo, const __m256i hi, const char value) {
+                const __m256i v = _mm256_set1_epi8(value);
+                const uint64_t m0 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, v)));
+                const uint64_t m1 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, v)));
+                return m0 | (m1 << 32);
+            }
+
+            __attribute__((target("avx2")))
+            void load(const char* p, uint64_t& quotes, uint64_t& separators, uint64_t& breaks) const {
+                const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+                quotes = mask(lo, hi, quote);
+                separators = mask(lo, hi, separator);
+                breaks = mask(lo, hi, '\n');
+            }
+        };
+
+        // flatten inlines the block loop into this function, so it is all compiled for avx2
+        __attribute__((target("avx2"), flatten))
+        size_t scan_avx2(const char* data, const size_t size, const char separator, const char quote,
+                         const bool line_breaks, bool& in_quotes, std::vector<size_t>& indexes) {
+            return scan_blocks<avx2_loader>(data, size, separator, quote, line_breaks, in_quotes, indexes);
+        }
+
+        __attribute__((target("avx2")))
+        size_t find_avx2(const char* data, const size_t size, const char separator, const char quote) {
+            const __m256i s = _mm256_set1_epi8(separator);
+            const __m256i q = _mm256_set1_epi8(quote);
+            const __m256i cr = _mm256_set1_epi8('\r');
+            const __m256i lf = _mm256_set1_epi8('\n');
+            size_t i = 0;
+
+            for (; i + 32 <= size; i += 32) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                const __m256i hits = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, s), _mm256_cmpeq_epi8(v, q)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf)));
+                const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+                if (mask != 0) {
+                    return i + trailing_zeros(mask);
+                }
+            }
+
+            return i + find_sse2(data + i, size - i, separator, quote);
+        }
+#endif
+
+        csv_scanner::find_function finder_for(const csv_scanner::engine e) {
+            switch (e) {
+#ifdef SEVILLA_AVX2
+                case csv_scanner::engine::avx2:
+                    return find_avx2;
+#endif
+#ifdef SEVILLA_SSE2
+                case csv_scanner::engine::sse2:
+                    return find_sse2;
+#endif
+                default:
+                    return find_scalar;
+            }
+        }
+
+        csv_scanner::scan_function function_for(const csv_scanner::engine e) {
+            switch (e) {
+#ifdef SEVILLA_AVX2
+                case csv_scanner::engine::avx2:
+                    return scan_avx2;
+#endif
+#ifdef SEVILLA_SSE2
+                case csv_scanner::engine::sse2:
+                    return scan_sse2;
+#endif
+                default:
+                    return scan_scalar;
+            }
+        }
+
+    }
+
+    csv_scanner::csv_scanner() : csv_scanner(best_engine()) {}
+
+    csv_scanner::csv_scanner(const engine e) : selected(e), function(function_for(e)), finder(finder_for(e)) {
+        if (!supported(e)) {
+            throw std::invalid_argument("Scanner engine is not supported: " + engine_name(e));
+        }
+    }
+
+    size_t csv_scanner::scan(const char* data, const size_t size, const char separator, const char quote,
+                             const bool line_breaks, bool& in_quotes) {
+        return function(data, size, separator, quote, line_breaks, in_quotes, indexes);
+    }
+
+    size_t csv_scanner::find_special(const char* data, const size_t size, const char separator,
+                                     const char quote) const {
+        return finder(data, size, separator, quote);
+    }
+
+    const size_t* csv_scanner::offsets() const {
+        return indexes.data();
+    }
+
+    csv_scanner::engine csv_scanner::get_engine() const {
+        return selected;
+    }
+
+    bool csv_scanner::supported(const engine e) {
+        switch (e) {
+            case engine::scalar:
+                return true;
+            case engine::sse2:
+#ifdef SEVILLA_SSE2
+                return true;
+#else
+                return false;
+#endif
+            case engine::avx2:
+#ifdef SEVILLA_AVX2
+                return __builtin_cpu_supports("avx2");
+#else
+                return false;
+#endif
+        }
+        return false;
+    }
+
+    csv_scanner::engine csv_scanner::best_engine() {
+        static const engine best = supported(engine::avx2) ? engine::avx2
+                                 : supported(engine::sse2) ? engine::sse2
+                                 : engine::scalar;
+        return best;
+    }
+
+    std::string csv_scanner::engine_name(const engine e) {
+        switch (e) {
+            case engine::scalar:
+                return "scalar";
+            case engine::sse2:
+                return "sse2";
+            case engine::avx2:
+                return "avx2";
+        }
+        return "unknown";
+    }
+
+}
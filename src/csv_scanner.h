@@ -0,0 +1,86 @@
+//
+// Created by Andres Jaimes on 05/07/25.
+//
+
+#ifndef CSV_SCANNER_H
+#define CSV_SCANNER_H
+
+#include <string>
+#include <vector>
+
+namespace sevilla {
+
+    /**
+     * Finds the structural characters of csv data (separators, quotes and line breaks),
+     * 64 bytes at a time when the cpu allows it.
+     */
+    class csv_scanner {
+
+    public:
+        enum class engine {
+            scalar,
+            sse2,
+            avx2
+        };
+
+        using scan_function = size_t (*)(const char* data, size_t size, char separator, char quote,
+                                         bool line_breaks, bool& in_quotes, std::vector<size_t>& indexes);
+
+        using find_function = size_t (*)(const char* data, size_t size, char separator, char quote);
+
+    private:
+        engine selected;
+        scan_function function;
+        find_function finder;
+        std::vector<size_t> indexes;
+
+    public:
+        /**
+         * Uses the fastest engine supported by the running cpu.
+         */
+        csv_scanner();
+
+        /**
+         * Uses the given engine. Throws if the running cpu does not support it.
+         */
+        explicit csv_scanner(engine e);
+
+        /**
+         * Scans `size` bytes and records the offsets of every quote, and of every separator
+         * outside quotes. When `line_breaks` is set, line feeds outside quotes are recorded too,
+         * and the scan stops at the first one. `in_quotes` carries the quoted state in and out
+         * of the call, so data can be scanned in pieces.
+         * Returns the number of offsets found, readable through `offsets()`.
+         */
+        size_t scan(const char* data, size_t size, char separator, char quote, bool line_breaks, bool& in_quotes);
+
+        /**
+         * Returns the offset of the first separator, quote, carriage return or line feed,
+         * or `size` when there is none. Fields without any of them need no quoting.
+         */
+        size_t find_special(const char* data, size_t size, char separator, char quote) const;
+
+        /**
+         * Returns the offsets found by the last scan, in ascending order.
+         */
+        const size_t* offsets() const;
+
+        engine get_engine() const;
+
+        /**
+         * Returns whether the running cpu supports an engine.
+         */
+        static bool supported(engine e);
+
+        /**
+         * Returns the fastest engine supported by the running cpu.
+         */
+        static engine best_engine();
+
+        static std::string engine_name(engine e);
+
+    };
+
+}
+
+#endif //CSV_SCANNER_H
@@ -0,0 +1,162 @@
+//
+// Created by Andres Jaimes on 27/09/25.
+//
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include "csv_schema.h"
+
+namespace sevilla {
+
+    namespace {
+
+        /**
+         * The types that every non-empty field of a column seen so far parses as.
+         */
+        struct column_stats {
+            bool int64 = true;
+            bool float64 = true;
+            bool boolean = true;
+            bool timestamp = true;
+            size_t values = 0;
+            bool nullable = false;
+
+            void add(const std::string_view field) {
+                if (field.empty()) {
+                    nullable = true;
+                    return;
+                }
+                values++;
+
+                int64_t i;
+                double d;
+                bool b;
+                // an integer is also a double, so only the failures are parsed twice
+                int64 = int64 && parse_int64(field, i);
+                float64 = float64 && (int64 || parse_double(field, d));
+                boolean = boolean && parse_bool(field, b);
+                timestamp = timestamp && parse_timestamp(field, i);
+            }
+
+            csv_type type() const {
+                if (values == 0) {
+                    return csv_type::utf8;
+                }
+                if (int64) {
+                    return csv_type::int64;
+                }
+                if (float64) {
+                    return csv_type::float64;
+                }
+                if (boolean) {
+                    return csv_type::boolean;
+                }
+                if (timestamp) {
+                    return csv_type::timestamp;
+                }
+                return csv_type::utf8;
+            }
+        };
+
+        /**
+         * Adds the fields of a record, after `rows` others.
+         */
+        void add_record(std::vector<column_stats>& stats, const csv_parser& record, const size_t rows) {
+            if (record.size() > stats.size()) {
+                // the earlier records did not have the new columns
+                const size_t known = stats.size();
+                stats.resize(record.size());
+                for (size_t i = known; i < stats.size(); i++) {
+                    stats[i].nullable = rows > 0;
+                }
+            }
+            for (size_t i = 0; i < stats.size(); i++) {
+                if (i < record.size()) {
+                    stats[i].add(record.view(i));
+                } else {
+                    stats[i].nullable = true;
+                }
+            }
+        }
+
+    }
+
+    std::vector<csv_type> csv_schema::types() const {
+        std::vector<csv_type> result;
+        result.reserve(columns.size());
+        for (const csv_column_schema& column : columns) {
+            result.push_back(column.type);
+        }
+        return result;
+    }
+
+    csv_schema_inferrer::csv_schema_inferrer(const size_t head_rows, const size_t sample_rows, const uint64_t seed)
+        : head_rows(head_rows), sample_rows(sample_rows), seed(seed) {}
+
+    csv_schema csv_schema_inferrer::infer(const char* data, const size_t size, const csv_dialect& dialect) const {
+        csv_reader reader;
+        reader.open(data, size, dialect);
+        return infer(reader, size);
+    }
+
+    csv_schema csv_schema_inferrer::infer_file(const std::string& path, const csv_dialect& dialect) const {
+        csv_reader reader;
+        reader.open(path, dialect);
+        return infer(reader, static_cast<size_t>(std::filesystem::file_size(path)));
+    }
+
+    csv_schema csv_schema_inferrer::infer(csv_reader& reader, const size_t size) const {
+        const csv_header& header = reader.record().get_header();
+        std::vector<column_stats> stats(header.size());
+        size_t rows = 0;
+
+        bool more = true;
+        while (rows < head_rows && (more = reader.next())) {
+            add_record(stats, reader.record(), rows);
+            rows++;
+        }
+
+        // sample the rest at sorted random offsets, so the reader only moves forward
+        if (more && rows > 0 && sample_rows > 0 && !reader.compressed() && reader.offset() + 1 < size) {
+            const size_t width = stats.size();
+            const size_t from = reader.offset() + 1;
+
+            std::mt19937_64 random(seed);
+            std::uniform_int_distribution<size_t> distribution(from, size - 1);
+            std::vector<size_t> offsets(sample_rows);
+            for (size_t& offset : offsets) {
+                offset = distribution(random);
+            }
+            std::sort(offsets.begin(), offsets.end());
+
+            size_t last = reader.offset();
+            for (const size_t offset : offsets) {
+                // an offset before the last record read would land on it again
+                if (offset <= last) {
+                    continue;
+                }
+                reader.seek(offset);
+                if (!reader.next()) {
+                    break;
+                }
+                last = reader.offset();
+                if (reader.size() == width) {
+                    add_record(stats, reader.record(), rows);
+                    rows++;
+                }
+            }
+        }
+
+        csv_schema schema;
+        schema.rows = rows;
+        for (size_t i = 0; i < stats.size(); i++) {
+            csv_column_schema& column = schema.columns.emplace_back();
+            column.name = i < header.size() ? header.name(i) : std::string();
+            column.type = stats[i].type();
+            column.nullable = stats[i].nullable;
+        }
+        return schema;
+    }
+
+}
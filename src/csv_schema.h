@@ -0,0 +1,85 @@
+//
+// Created by Andres Jaimes on 27/09/25.
+//
+
+#ifndef CSV_SCHEMA_H
+#define CSV_SCHEMA_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "csv_reader.h"
+#include "csv_sniffer.h"
+#include "csv_types.h"
+
+namespace sevilla {
+
+    struct csv_column_schema {
+        /**
+         * The column name from the header, or empty without one.
+         */
+        std::string name;
+
+        csv_type type = csv_type::utf8;
+
+        /**
+         * Whether an empty or missing field was seen.
+         */
+        bool nullable = false;
+    };
+
+    /**
+     * The columns of a csv file, as far as a sample of its records shows.
+     */
+    struct csv_schema {
+        std::vector<csv_column_schema> columns;
+
+        /**
+         * The number of records the schema was inferred from.
+         */
+        size_t rows = 0;
+
+        /**
+         * Returns the column types, for `csv_column_batch::set_types`.
+         */
+        std::vector<csv_type> types() const;
+    };
+
+    /**
+     * Infers column types from the first records of csv data and a random sample of the rest.
+     * A column gets the narrowest type that every non-empty field parses as: int64, float64,
+     * boolean, timestamp, and utf8 otherwise. Fields are parsed with the conversions in
+     * `csv_types`, the same ones `csv_column_batch` uses.
+     *
+     * Sampled records start at the first line after a random offset, so one may start inside
+     * a quoted field; those with a different number of fields than the first records are left
+     * out. Compressed data is only read from its start.
+     */
+    class csv_schema_inferrer {
+
+    private:
+        size_t head_rows;
+        size_t sample_rows;
+        uint64_t seed;
+
+        csv_schema infer(csv_reader& reader, size_t size) const;
+
+    public:
+        /**
+         * Reads up to `head_rows` records from the start, and up to `sample_rows` records at
+         * random offsets after them. The same seed samples the same records.
+         */
+        explicit csv_schema_inferrer(size_t head_rows = 1000, size_t sample_rows = 1000, uint64_t seed = 0);
+
+        csv_schema infer(const char* data, size_t size, const csv_dialect& dialect = {}) const;
+
+        /**
+         * Maps a file and infers its schema. Throws if the file cannot be opened or mapped.
+         */
+        csv_schema infer_file(const std::string& path, const csv_dialect& dialect = {}) const;
+
+    };
+
+}
+
+#endif //CSV_SCHEMA_H
@@ -0,0 +1,89 @@
+//
+// Created by Andres Jaimes on 27/09/25.
+//
+
+#include "c_api.h"
+#include "csv_schema.h"
+#include "json.hpp"
+
+namespace {
+
+    const char* type_name(const sevilla::csv_type type) {
+        switch (type) {
+            case sevilla::csv_type::int64: return "int64";
+            case sevilla::csv_type::float64: return "float64";
+            case sevilla::csv_type::boolean: return "boolean";
+            case sevilla::csv_type::timestamp: return "timestamp";
+            default: return "utf8";
+        }
+    }
+
+    std::string to_json(const sevilla::csv_schema& schema) {
+        nlohmann::json columns = nlohmann::json::array();
+        for (const sevilla::csv_column_schema& column : schema.columns) {
+            nlohmann::json c;
+            c["name"] = column.name;
+            c["type"] = type_name(column.type);
+            c["type_id"] = static_cast<int>(column.type);
+            c["nullable"] = column.nullable;
+            columns.push_back(c);
+        }
+
+        nlohmann::json j;
+        j["rows"] = schema.rows;
+        j["columns"] = columns;
+        return j.dump();
+    }
+
+    sevilla::csv_dialect make_dialect(const char separator, const int header) {
+        sevilla::csv_dialect dialect;
+        dialect.separator = separator;
+        dialect.header = header != 0;
+        return dialect;
+    }
+
+}
+
+/**
+ * Infers the column types of csv data from its first 1000 records and 1000 more at random.
+ * With `header`, the first record names the columns. Returns a json object with the number
+ * of `rows` sampled and the `columns`, each with a `name`, a `type`, the `type_id` that
+ * sv_csv_columns_set_type takes, and whether it is `nullable`; or with an `error`.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_infer_schema(const char* data, const size_t size, const char separator, const int header) {
+    thread_local std::string result;
+
+    try {
+        result = to_json(sevilla::csv_schema_inferrer().infer(data, size, make_dialect(separator, header)));
+    } catch (std::exception& e) {
+        result = make_error(e.what());
+    } catch (...) {
+        result = make_error("Unknown exception");
+    }
+
+    return result.c_str();
+}
+
+/**
+ * Like sv_csv_infer_schema, sampling a memory-mapped file.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_infer_schema_file(const char* path, const char separator, const int header) {
+    thread_local std::string result;
+
+    if (path == nullptr) {
+        result = make_error("No file given");
+        return result.c_str();
+    }
+
+    try {
+        result = to_json(sevilla::csv_schema_inferrer().infer_file(path, make_dialect(separator, header)));
+    } catch (std::exception& e) {
+        result = make_error(e.what());
+    } catch (...) {
+        result = make_error("Unknown exception");
+    }
+
+    return result.c_str();
+}
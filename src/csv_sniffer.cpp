@@ -0,0 +1,245 @@
+//
+// Created by Andres Jaimes on 30/08/25.
+//
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <vector>
+#include "csv_parser.h"
+#include "csv_sniffer.h"
+#include "csv_types.h"
+
+namespace sevilla {
+
+    namespace {
+
+        constexpr char separators[] = {',', '\t', ';', '|', ':'};
+        constexpr char quotes[] = {'"', '\''};
+        constexpr size_t max_records = 200;
+
+        using records = std::vector<std::vector<std::string>>;
+
+        /**
+         * Parses up to `max_records` records, skipping blank lines.
+         */
+        records read_records(const std::string_view text, const char separator, const char quote) {
+            csv_parser parser;
+            parser.set_quote(quote);
+            records result;
+            size_t position = 0;
+
+            while (position < text.size() && result.size() < max_records) {
+                position += parser.parse_record(text.substr(position), separator);
+                if (parser.size() == 1 && parser.view(0).empty()) {
+                    continue;
+                }
+                std::vector<std::string>& fields = result.emplace_back();
+                for (size_t i = 0; i < parser.size(); i++) {
+                    fields.emplace_back(parser.view(i));
+                }
+            }
+            return result;
+        }
+
+        /**
+         * Returns the most common field count, and how many records have it.
+         */
+        std::pair<size_t, size_t> common_width(const records& rows) {
+            std::map<size_t, size_t> histogram;
+            for (const auto& row : rows) {
+                histogram[row.size()]++;
+            }
+
+            std::pair<size_t, size_t> best{0, 0};
+            for (const auto& [width, count] : histogram) {
+                if (count > best.second || (count == best.second && width > best.first)) {
+                    best = {width, count};
+                }
+            }
+            return best;
+        }
+
+        /**
+         * Counts the quotes that open or close a field: those next to a line boundary or a
+         * candidate separator. Apostrophes inside words do not count.
+         */
+        size_t boundary_quotes(const std::string_view text, const char quote) {
+            const auto boundary = [](const char c) {
+                return c == '\n' || c == '\r' || std::find(std::begin(separators), std::end(separators), c) != std::end(separators);
+            };
+
+            size_t count = 0;
+            for (size_t i = 0; i < text.size(); i++) {
+                if (text[i] == quote && (i == 0 || i + 1 == text.size() || boundary(text[i - 1]) || boundary(text[i + 1]))) {
+                    count++;
+                }
+            }
+            return count;
+        }
+
+        enum class kind { empty, number, boolean, timestamp, text };
+
+        kind kind_of(const std::string_view field) {
+            int64_t i;
+            double d;
+            bool b;
+            if (field.empty()) {
+                return kind::empty;
+            }
+            if (parse_int64(field, i) || parse_double(field, d)) {
+                return kind::number;
+            }
+            if (parse_bool(field, b)) {
+                return kind::boolean;
+            }
+            if (parse_timestamp(field, i)) {
+                return kind::timestamp;
+            }
+            return kind::text;
+        }
+
+        /**
+         * Votes, column by column, on whether the first record differs from the rest: by type
+         * when the rest share a type, or by length when they are text of a single length.
+         */
+        bool has_header(const records& rows, const size_t columns) {
+            if (rows.size() < 2 || rows[0].size() != columns) {
+                return false;
+            }
+
+            int votes = 0;
+            for (size_t c = 0; c < columns; c++) {
+                kind shared = kind::empty;
+                size_t length = std::string::npos;
+                bool same_kind = true;
+                bool same_length = true;
+
+                for (size_t r = 1; r < rows.size(); r++) {
+                    if (rows[r].size() != columns) {
+                        continue;
+                    }
+                    const std::string& field = rows[r][c];
+                    const kind k = kind_of(field);
+                    if (k == kind::empty) {
+                        continue;
+                    }
+                    if (shared == kind::empty) {
+                        shared = k;
+                        length = field.size();
+                    }
+                    same_kind = same_kind && k == shared;
+                    same_length = same_length && field.size() == length;
+                }
+
+                if (shared == kind::empty || !same_kind) {
+                    continue;
+                }
+                const std::string& first = rows[0][c];
+                if (shared != kind::text) {
+                    votes += kind_of(first) != shared ? 1 : -1;
+                } else if (same_length) {
+                    votes += first.size() != length ? 1 : -1;
+                }
+            }
+            return votes > 0;
+        }
+
+    }
+
+    csv_sniffer::csv_sniffer(const size_t sample_size) : sample_size(sample_size) {}
+
+    csv_dialect csv_sniffer::sniff(const char* data, const size_t size) const {
+        csv_dialect dialect;
+        if (data == nullptr || size == 0) {
+            return dialect;
+        }
+
+        // leave out the last line when the sample cuts it
+        std::string_view sample(data, std::min(size, sample_size));
+        if (sample.size() < size) {
+            const size_t last = sample.find_last_of("\r\n");
+            if (last != std::string_view::npos) {
+                sample = sample.substr(0, last + 1);
+            }
+        }
+
+        size_t crlf = 0;
+        size_t lf = 0;
+        size_t cr = 0;
+        for (size_t i = 0; i < sample.size(); i++) {
+            if (sample[i] == '\r') {
+                if (i + 1 < sample.size() && sample[i + 1] == '\n') {
+                    crlf++;
+                    i++;
+                } else {
+                    cr++;
+                }
+            } else if (sample[i] == '\n') {
+                lf++;
+            }
+        }
+        if (crlf > 0 && crlf >= lf && crlf >= cr) {
+            dialect.line_break = "\r\n";
+        } else if (cr > lf) {
+            dialect.line_break = "\r";
+        }
+
+        // the parser only ends records at line feeds
+        std::string converted;
+        if (dialect.line_break == "\r") {
+            converted.assign(sample);
+            std::replace(converted.begin(), converted.end(), '\r', '\n');
+            sample = converted;
+        }
+
+        size_t best_quotes = 0;
+        for (const char quote : quotes) {
+            const size_t count = boundary_quotes(sample, quote);
+            if (count > best_quotes) {
+                best_quotes = count;
+                dialect.quote = quote;
+            }
+        }
+
+        records best;
+        size_t best_score = 0;
+        for (const char separator : separators) {
+            records rows = read_records(sample, separator, dialect.quote);
+            const auto [width, count] = common_width(rows);
+            if (width > 1 && count > best_score) {
+                best_score = count;
+                dialect.separator = separator;
+                dialect.columns = width;
+                best = std::move(rows);
+            }
+        }
+
+        if (best_score == 0) {
+            best = read_records(sample, dialect.separator, dialect.quote);
+            dialect.columns = common_width(best).first;
+        }
+        dialect.header = has_header(best, dialect.columns);
+
+        return dialect;
+    }
+
+    csv_dialect csv_sniffer::sniff_file(const std::string& path) const {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Unable to open file: " + path);
+        }
+
+        // read one byte past the sample, to know whether the sample cuts the data
+        std::string sample(sample_size + 1, '\0');
+        file.read(sample.data(), static_cast<std::streamsize>(sample.size()));
+        if (file.bad()) {
+            throw std::runtime_error("Unable to read file: " + path);
+        }
+        sample.resize(static_cast<size_t>(file.gcount()));
+
+        return sniff(sample.data(), sample.size());
+    }
+
+}
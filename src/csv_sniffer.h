@@ -0,0 +1,65 @@
+//
+// Created by Andres Jaimes on 30/08/25.
+//
+
+#ifndef CSV_SNIFFER_H
+#define CSV_SNIFFER_H
+
+#include <string>
+
+namespace sevilla {
+
+    /**
+     * How a csv file is written.
+     */
+    struct csv_dialect {
+        char separator = ',';
+        char quote = '"';
+
+        /**
+         * "\n", "\r\n" or "\r". Records only end at line feeds, so `csv_reader` refuses
+         * "\r", and files that use it have to be converted first.
+         */
+        std::string line_break = "\n";
+
+        /**
+         * Whether the first record holds column names.
+         */
+        bool header = false;
+
+        /**
+         * The most common number of fields per record.
+         */
+        size_t columns = 0;
+    };
+
+    /**
+     * Guesses the dialect of csv data from a sample at its start, by frequency analysis:
+     * the separator is the candidate (`,`, tab, `;`, `|` or `:`) that splits most records
+     * into the same number of fields, and a header is detected when the first record's
+     * fields do not look like the values below them.
+     */
+    class csv_sniffer {
+
+    private:
+        size_t sample_size;
+
+    public:
+        /**
+         * Looks at no more than `sample_size` bytes of data.
+         */
+        explicit csv_sniffer(size_t sample_size = 64 * 1024);
+
+        csv_dialect sniff(const char* data, size_t size) const;
+
+        /**
+         * Reads the start of a file and sniffs it. Throws std::runtime_error when the file
+         * cannot be read.
+         */
+        csv_dialect sniff_file(const std::string& path) const;
+
+    };
+
+}
+
+#endif //CSV_SNIFFER_H
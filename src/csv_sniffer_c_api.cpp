@@ -0,0 +1,63 @@
+//
+// Created by Andres Jaimes on 30/08/25.
+//
+
+#include "c_api.h"
+#include "csv_sniffer.h"
+#include "json.hpp"
+
+namespace {
+
+    std::string to_json(const sevilla::csv_dialect& dialect) {
+        nlohmann::json j;
+        j["separator"] = std::string(1, dialect.separator);
+        j["quote"] = std::string(1, dialect.quote);
+        j["line_break"] = dialect.line_break;
+        j["header"] = dialect.header;
+        j["columns"] = dialect.columns;
+        return j.dump();
+    }
+
+}
+
+/**
+ * Guesses the dialect of csv data from its first 64 KB. Returns a json object with the
+ * `separator`, `quote`, `line_break`, `header` and `columns` found, or with an `error`.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_sniff(const char* data, const size_t size) {
+    thread_local std::string result;
+
+    try {
+        result = to_json(sevilla::csv_sniffer().sniff(data, size));
+    } catch (std::exception& e) {
+        result = make_error(e.what());
+    } catch (...) {
+        result = make_error("Unknown exception");
+    }
+
+    return result.c_str();
+}
+
+/**
+ * Like sv_csv_sniff, reading the first 64 KB of a file.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_sniff_file(const char* path) {
+    thread_local std::string result;
+
+    if (path == nullptr) {
+        result = make_error("No file given");
+        return result.c_str();
+    }
+
+    try {
+        result = to_json(sevilla::csv_sniffer().sniff_file(path));
+    } catch (std::exception& e) {
+        result = make_error(e.what());
+    } catch (...) {
+        result = make_error("Unknown exception");
+    }
+
+    return result.c_str();
+}
@@ -0,0 +1,492 @@
+//
+// Created by Andres Jaimes on 14/10/25.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include "csv_reader.h"
+#include "csv_sorter.h"
+#include "csv_table.h"
+#include "csv_types.h"
+#include "csv_writer.h"
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace sevilla {
+
+    namespace {
+
+        /**
+         * The most runs merged at once. More runs are merged in several passes, so the
+         * number of open files stays bounded.
+         */
+        constexpr size_t max_fan_in = 128;
+
+        /**
+         * An output file, closed when it goes out of scope.
+         */
+        class output_file {
+
+        private:
+            int fd;
+
+        public:
+            explicit output_file(const std::string& path) {
+#if defined(_WIN32)
+                fd = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+                fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+                if (fd < 0) {
+                    throw std::runtime_error("Unable to create file: " + path);
+                }
+            }
+
+            ~output_file() {
+#if defined(_WIN32)
+                _close(fd);
+#else
+                ::close(fd);
+#endif
+            }
+
+            output_file(const output_file&) = delete;
+            output_file& operator=(const output_file&) = delete;
+
+            int get() const {
+                return fd;
+            }
+
+        };
+
+        /**
+         * Names the temporary run files, and removes them when it goes out of scope.
+         */
+        class run_files {
+
+        private:
+            std::filesystem::path directory;
+            std::string prefix;
+            std::vector<std::string> paths;
+
+        public:
+            explicit run_files(const std::string& directory)
+                : directory(directory.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(directory)) {
+                std::random_device random;
+                prefix = "sevilla-sort-" + std::to_string(random()) + "-";
+            }
+
+            ~run_files() {
+                for (const std::string& path : paths) {
+                    std::error_code ignored;
+                    std::filesystem::remove(path, ignored);
+                }
+            }
+
+            run_files(const run_files&) = delete;
+            run_files& operator=(const run_files&) = delete;
+
+            std::string add() {
+                paths.push_back((directory / (prefix + std::to_string(paths.size()) + ".csv")).string());
+                return paths.back();
+            }
+
+            bool empty() const {
+                return paths.empty();
+            }
+
+            const std::vector<std::string>& all() const {
+                return paths;
+            }
+
+        };
+
+        std::string_view field_or_empty(const csv_table& table, const size_t row, const size_t column) {
+            return column < table.row_size(row) ? table.field(row, column) : std::string_view();
+        }
+
+        std::string_view field_or_empty(const csv_parser& record, const size_t column) {
+            return column < record.size() ? record.view(column) : std::string_view();
+        }
+
+        int compare_text(const std::string_view a, const std::string_view b) {
+            const int result = a.compare(b);
+            return result < 0 ? -1 : result > 0 ? 1 : 0;
+        }
+
+        /**
+         * Parses a numeric key. NaN has no place among numbers, so a strict weak order
+         * needs it to sort as text, like any other field that is not a number.
+         */
+        bool parse_key(const std::string_view field, double& value) {
+            return parse_double(field, value) && !std::isnan(value);
+        }
+
+        /**
+         * Numbers go before other fields, which are compared as text. Only numbers follow
+         * `descending`, so other fields stay last, in byte order.
+         */
+        int compare_numbers(const bool has_a, const double a, const bool has_b, const double b,
+                            const std::string_view text_a, const std::string_view text_b, const bool descending) {
+            if (has_a && has_b) {
+                const int result = a < b ? -1 : a > b ? 1 : 0;
+                return descending ? -result : result;
+            }
+            if (has_a != has_b) {
+                return has_a ? -1 : 1;
+            }
+            return compare_text(text_a, text_b);
+        }
+
+        int compare_field(const std::string_view a, const std::string_view b, const csv_sort_key& key) {
+            if (key.numeric) {
+                double x = 0;
+                double y = 0;
+                const bool has_x = parse_key(a, x);
+                const bool has_y = parse_key(b, y);
+                return compare_numbers(has_x, x, has_y, y, a, b, key.descending);
+            }
+            const int result = compare_text(a, b);
+            return key.descending ? -result : result;
+        }
+
+        /**
+         * Compares two records by their keys, given functions that return key `k` of each.
+         */
+        template <typename A, typename B>
+        int compare_keys(const std::vector<csv_sort_key>& keys, A a, B b) {
+            for (size_t k = 0; k < keys.size(); k++) {
+                const int result = compare_field(a(k), b(k), keys[k]);
+                if (result != 0) {
+                    return result;
+                }
+            }
+            return 0;
+        }
+
+        /**
+         * Returns the rows of `table` in key order. Numeric keys are parsed once per row,
+         * rather than once per comparison.
+         */
+        std::vector<size_t> sorted_rows(const csv_table& table, const std::vector<csv_sort_key>& keys) {
+            const size_t rows = table.rows();
+            std::vector<std::vector<double>> numbers(keys.size());
+            std::vector<std::vector<char>> parsed(keys.size());
+            for (size_t k = 0; k < keys.size(); k++) {
+                if (!keys[k].numeric) {
+                    continue;
+                }
+                numbers[k].resize(rows);
+                parsed[k].resize(rows);
+                for (size_t r = 0; r < rows; r++) {
+                    parsed[k][r] = parse_key(field_or_empty(table, r, keys[k].column), numbers[k][r]);
+                }
+            }
+
+            std::vector<size_t> order(rows);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+                for (size_t k = 0; k < keys.size(); k++) {
+                    const csv_sort_key& key = keys[k];
+                    const std::string_view x = field_or_empty(table, a, key.column);
+                    const std::string_view y = field_or_empty(table, b, key.column);
+                    int result;
+                    if (key.numeric) {
+                        result = compare_numbers(parsed[k][a], numbers[k][a], parsed[k][b], numbers[k][b], x, y,
+                                                 key.descending);
+                    } else {
+                        result = compare_text(x, y);
+                        if (key.descending) {
+                            result = -result;
+                        }
+                    }
+                    if (result != 0) {
+                        return result < 0;
+                    }
+                }
+                return false;
+            });
+            return order;
+        }
+
+        /**
+         * Writes the rows of `table` in key order, or, with `group`, one row per key with its
+         * fields and count. Returns the number of rows written.
+         */
+        size_t write_sorted(const csv_table& table, const std::vector<csv_sort_key>& keys, const bool group,
+                            csv_writer& writer) {
+            const std::vector<size_t> order = sorted_rows(table, keys);
+
+            if (!group) {
+                for (const size_t row : order) {
+                    for (size_t c = 0; c < table.row_size(row); c++) {
+                        writer.write_field(table.field(row, c));
+                    }
+                    writer.end_row();
+                }
+                return order.size();
+            }
+
+            size_t groups = 0;
+            for (size_t i = 0; i < order.size();) {
+                const size_t first = order[i];
+                size_t count = 0;
+                for (; i < order.size(); i++, count++) {
+                    const size_t row = order[i];
+                    const int result = compare_keys(keys,
+                        [&](const size_t k) { return field_or_empty(table, first, keys[k].column); },
+                        [&](const size_t k) { return field_or_empty(table, row, keys[k].column); });
+                    if (result != 0) {
+                        break;
+                    }
+                }
+
+                for (const csv_sort_key& key : keys) {
+                    writer.write_field(field_or_empty(table, first, key.column));
+                }
+                writer.write_field(std::to_string(count));
+                writer.end_row();
+                groups++;
+            }
+            return groups;
+        }
+
+        /**
+         * Merges sorted runs into `writer`. Key `k` is in column `positions[k]` of the runs.
+         * With `group`, runs hold keys and counts, and the counts of equal keys are added up.
+         * Equal records keep the order of their runs. Returns the number of rows written.
+         */
+        size_t merge(const std::vector<std::string>& runs, const std::vector<csv_sort_key>& keys,
+                     const std::vector<size_t>& positions, const bool group, const char separator, csv_writer& writer) {
+            std::vector<std::unique_ptr<csv_reader>> readers;
+            for (const std::string& path : runs) {
+                readers.push_back(std::make_unique<csv_reader>());
+                readers.back()->open(path, separator);
+            }
+
+            const auto key_of = [&](const size_t run) {
+                return [&, run](const size_t k) { return field_or_empty(readers[run]->record(), positions[k]); };
+            };
+            // a min-heap: the run with the smallest record, or the first of equal ones, on top
+            const auto later = [&](const size_t a, const size_t b) {
+                const int result = compare_keys(keys, key_of(a), key_of(b));
+                return result != 0 ? result > 0 : a > b;
+            };
+            std::priority_queue<size_t, std::vector<size_t>, decltype(later)> heap(later);
+            for (size_t run = 0; run < readers.size(); run++) {
+                if (readers[run]->next()) {
+                    heap.push(run);
+                }
+            }
+
+            size_t rows = 0;
+            std::vector<std::string> current(keys.size());
+            int64_t count = 0;
+            bool pending = false;
+
+            const auto emit = [&] {
+                for (const std::string& field : current) {
+                    writer.write_field(field);
+                }
+                writer.write_field(std::to_string(count));
+                writer.end_row();
+                rows++;
+            };
+
+            while (!heap.empty()) {
+                const size_t run = heap.top();
+                heap.pop();
+                const csv_parser& record = readers[run]->record();
+
+                if (!group) {
+                    writer.write_row(record);
+                    rows++;
+                } else {
+                    int64_t n = 0;
+                    parse_int64(field_or_empty(record, keys.size()), n);
+                    const bool same = pending && compare_keys(keys,
+                        [&](const size_t k) { return std::string_view(current[k]); },
+                        key_of(run)) == 0;
+                    if (same) {
+                        count += n;
+                    } else {
+                        if (pending) {
+                            emit();
+                        }
+                        for (size_t k = 0; k < keys.size(); k++) {
+                            current[k].assign(field_or_empty(record, positions[k]));
+                        }
+                        count = n;
+                        pending = true;
+                    }
+                }
+
+                if (readers[run]->next()) {
+                    heap.push(run);
+                }
+            }
+
+            if (pending) {
+                emit();
+            }
+            return rows;
+        }
+
+        /**
+         * Roughly the memory a chunk takes while it is sorted: its bytes and offsets, plus
+         * the sort order and parsed numbers.
+         */
+        size_t footprint(const csv_table& table) {
+            return table.data().size() + (table.fields().size() + 2 * table.rows()) * sizeof(size_t);
+        }
+
+    }
+
+    csv_sorter::csv_sorter(std::vector<csv_sort_key> keys) : keys(std::move(keys)) {
+        if (this->keys.empty()) {
+            throw std::invalid_argument("At least one sort key is required");
+        }
+    }
+
+    void csv_sorter::set_memory_budget(const size_t bytes) {
+        memory_budget = bytes;
+    }
+
+    void csv_sorter::set_threads(const size_t count) {
+        threads = count;
+    }
+
+    void csv_sorter::set_temp_directory(const std::string& path) {
+        temp_directory = path;
+    }
+
+    size_t csv_sorter::sort(const std::string& input, const std::string& output, const csv_dialect& dialect) const {
+        return run(input, output, dialect, false);
+    }
+
+    size_t csv_sorter::group_count(const std::string& input, const std::string& output, const csv_dialect& dialect) const {
+        return run(input, output, dialect, true);
+    }
+
+    size_t csv_sorter::run(const std::string& input, const std::string& output, const csv_dialect& dialect,
+                           const bool group) const {
+        // truncating the output would truncate the mapped input under the reader
+        std::error_code ignored;
+        if (std::filesystem::equivalent(input, output, ignored)) {
+            throw std::invalid_argument("The output cannot be the input file: " + output);
+        }
+
+        csv_reader reader;
+        reader.open(input, dialect);
+        const char separator = dialect.separator;
+
+        // every worker holds a chunk while one more is read
+        const size_t workers = threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+        const size_t chunk_budget = std::max<size_t>(memory_budget / (workers + 1), 64 * 1024);
+
+        output_file out(output);
+        csv_writer writer(out.get(), separator);
+
+        if (dialect.header) {
+            const csv_header& header = reader.record().get_header();
+            if (group) {
+                for (const csv_sort_key& key : keys) {
+                    writer.write_field(key.column < header.size() ? header.name(key.column) : std::string());
+                }
+                writer.write_field("count");
+            } else {
+                for (size_t i = 0; i < header.size(); i++) {
+                    writer.write_field(header.name(i));
+                }
+            }
+            writer.end_row();
+        }
+
+        // declared before the workers, so their files outlive them
+        run_files runs(temp_directory);
+        std::deque<std::future<void>> spills;
+        csv_table table;
+
+        while (true) {
+            const bool more = reader.next();
+            if (more) {
+                table.append(reader.record());
+                if (footprint(table) < chunk_budget) {
+                    continue;
+                }
+            }
+            // data that fits in one chunk is never spilled
+            if ((!more && runs.empty()) || table.rows() == 0) {
+                break;
+            }
+
+            if (spills.size() >= workers) {
+                spills.front().get();
+                spills.pop_front();
+            }
+            spills.push_back(std::async(std::launch::async,
+                [this, group, separator, path = runs.add(), chunk = std::move(table)] {
+                    output_file file(path);
+                    csv_writer spill(file.get(), separator);
+                    write_sorted(chunk, keys, group, spill);
+                    spill.flush();
+                }));
+            table = csv_table();
+
+            if (!more) {
+                break;
+            }
+        }
+
+        for (std::future<void>& spill : spills) {
+            spill.get();
+        }
+
+        size_t rows;
+        if (runs.empty()) {
+            rows = write_sorted(table, keys, group, writer);
+        } else {
+            // runs of grouped keys hold the keys first
+            std::vector<size_t> positions;
+            for (size_t k = 0; k < keys.size(); k++) {
+                positions.push_back(group ? k : keys[k].column);
+            }
+
+            std::vector<std::string> level = runs.all();
+            while (level.size() > max_fan_in) {
+                std::vector<std::string> merged;
+                for (size_t i = 0; i < level.size(); i += max_fan_in) {
+                    const std::vector<std::string> batch(level.begin() + i,
+                                                         level.begin() + std::min(level.size(), i + max_fan_in));
+                    merged.push_back(runs.add());
+                    output_file file(merged.back());
+                    csv_writer spill(file.get(), separator);
+                    merge(batch, keys, positions, group, separator, spill);
+                    spill.flush();
+                }
+                level = std::move(merged);
+            }
+            rows = merge(level, keys, positions, group, separator, writer);
+        }
+
+        writer.flush();
+        return rows;
+    }
+
+}
@@ -0,0 +1,88 @@
+//
+// Created by Andres Jaimes on 14/10/25.
+//
+
+#ifndef CSV_SORTER_H
+#define CSV_SORTER_H
+
+#include <string>
+#include <vector>
+#include "csv_sniffer.h"
+
+namespace sevilla {
+
+    struct csv_sort_key {
+        size_t column = 0;
+
+        /**
+         * Compares fields as numbers. Fields that are not numbers, NaN included, go after
+         * those that are, in byte order, in either direction. Infinities sort as numbers.
+         */
+        bool numeric = false;
+
+        bool descending = false;
+    };
+
+    /**
+     * Sorts csv files, or counts their records by key, when they are larger than memory.
+     * Records are read into chunks that fit the memory budget, and every chunk is sorted
+     * and spilled to a temporary csv file, on worker threads. The files, or runs, are then
+     * merged into the output. Fields are parsed and written as csv, so quoted fields with
+     * separators and line breaks keep their place.
+     *
+     * Sorting is stable, and records that lack a key column sort as if it were empty.
+     * Output is written with double quotes, whatever the input used.
+     */
+    class csv_sorter {
+
+    private:
+        std::vector<csv_sort_key> keys;
+        size_t memory_budget = 256 * 1024 * 1024;
+        size_t threads = 0;
+        std::string temp_directory;
+
+        size_t run(const std::string& input, const std::string& output, const csv_dialect& dialect, bool group) const;
+
+    public:
+        /**
+         * Orders records by `keys`, the first one first. Throws std::invalid_argument
+         * without keys.
+         */
+        explicit csv_sorter(std::vector<csv_sort_key> keys);
+
+        /**
+         * Sets about how many bytes of records are held in memory at once, across every
+         * thread. Defaults to 256 MB.
+         */
+        void set_memory_budget(size_t bytes);
+
+        /**
+         * Sets how many chunks are sorted and spilled at the same time, or 0 for one per core.
+         */
+        void set_threads(size_t count);
+
+        /**
+         * Sets where runs are spilled. Defaults to the system's temporary directory.
+         */
+        void set_temp_directory(const std::string& path);
+
+        /**
+         * Writes the records of `input` to `output` in key order, after the header when the
+         * dialect has one. Returns the number of records written. Throws std::runtime_error
+         * when a file cannot be read or written, and std::invalid_argument when `output` is
+         * `input`.
+         */
+        size_t sort(const std::string& input, const std::string& output, const csv_dialect& dialect = {}) const;
+
+        /**
+         * Writes one record per distinct key to `output`, in key order: the key fields and
+         * the number of records that have them. With a header, the output header has the
+         * key names and `count`. Returns the number of keys.
+         */
+        size_t group_count(const std::string& input, const std::string& output, const csv_dialect& dialect = {}) const;
+
+    };
+
+}
+
+#endif //CSV_SORTER_H
@@ -0,0 +1,106 @@
+//
+// Created by Andres Jaimes on 14/10/25.
+//
+
+#include "c_api.h"
+#include "csv_sorter.h"
+#include "json.hpp"
+
+namespace {
+
+    /**
+     * Flags of a sort key: compare as numbers, and sort in descending order.
+     */
+    constexpr int key_numeric = 1;
+    constexpr int key_descending = 2;
+
+    sevilla::csv_sorter make_sorter(const size_t* columns, const int* flags, const size_t count, const size_t memory_mb) {
+        if (columns == nullptr) {
+            throw std::invalid_argument("No sort columns given");
+        }
+
+        std::vector<sevilla::csv_sort_key> keys;
+        for (size_t i = 0; i < count; i++) {
+            sevilla::csv_sort_key key;
+            key.column = columns[i];
+            if (flags != nullptr) {
+                key.numeric = (flags[i] & key_numeric) != 0;
+                key.descending = (flags[i] & key_descending) != 0;
+            }
+            keys.push_back(key);
+        }
+
+        sevilla::csv_sorter sorter(std::move(keys));
+        if (memory_mb > 0) {
+            sorter.set_memory_budget(memory_mb * 1024 * 1024);
+        }
+        return sorter;
+    }
+
+    sevilla::csv_dialect make_dialect(const char separator, const int header) {
+        sevilla::csv_dialect dialect;
+        dialect.separator = separator;
+        dialect.header = header != 0;
+        return dialect;
+    }
+
+}
+
+/**
+ * Sorts the csv file at `input` into `output`, by `count` key columns. `flags` holds, for
+ * every key, 1 to compare it as a number and 2 to sort it in descending order, and may be
+ * null. With `header`, the first record is kept first. `memory_mb` bounds the memory used,
+ * or 0 for the default. Returns a json object with the number of `rows` written, or with
+ * an `error`.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_sort(const char* input, const char* output, const size_t* columns, const int* flags,
+                        const size_t count, const char separator, const int header, const size_t memory_mb) {
+    thread_local std::string result;
+
+    if (input == nullptr || output == nullptr) {
+        result = make_error("No file given");
+        return result.c_str();
+    }
+
+    try {
+        const sevilla::csv_sorter sorter = make_sorter(columns, flags, count, memory_mb);
+        nlohmann::json j;
+        j["rows"] = sorter.sort(input, output, make_dialect(separator, header));
+        result = j.dump();
+    } catch (std::exception& e) {
+        result = make_error(e.what());
+    } catch (...) {
+        result = make_error("Unknown exception");
+    }
+
+    return result.c_str();
+}
+
+/**
+ * Like sv_csv_sort, writing every distinct key once, with the number of records that have
+ * it. Returns a json object with the number of `groups` written, or with an `error`.
+ */
+extern "C" DLL_EXPORT
+const char* sv_csv_group_count(const char* input, const char* output, const size_t* columns, const int* flags,
+                               const size_t count, const char separator, const int header, const size_t memory_mb) {
+    thread_local std::string result;
+
+    if (input == nullptr || output == nullptr) {
+        result = make_error("No file given");
+        return result.c_str();
+    }
+
+    try {
+        const sevilla::csv_sorter sorter = make_sorter(columns, flags, count, memory_mb);
+        nlohmann::json j;
+        j["groups"] = sorter.group_count(input, output, make_dialect(separator, header));
+        result = j.dump();
+    } catch (std::exception& e) {
+        result = make_error(e.what());
+    } catch (...) {
+        result = make_error("Unknown exception");
+    }
+
+    return result.c_str();
+}
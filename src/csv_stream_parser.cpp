@@ -0,0 +1,87 @@
+//
+// Created by Andres Jaimes on 26/07/25.
+//
+
+#include <algorithm>
+#include "csv_stream_parser.h"
+
+namespace sevilla {
+
+    csv_stream_parser::csv_stream_parser(const char separator, record_callback callback)
+        : callback(std::move(callback)), separator(separator) {}
+
+    csv_stream_parser::csv_stream_parser(const char separator, csv_handler& handler)
+        : callback([this, &handler](const csv_parser& record) { emit_csv_row(record, records - 1, handler); }),
+          separator(separator) {}
+
+    void csv_stream_parser::feed(const char* data, const size_t size) {
+        size_t position = 0;
+
+        // complete the pending record first, looking for its end in the new chunk only
+        if (!pending.empty()) {
+            bool quoted = in_quotes;
+            const size_t count = scanner.scan(data, size, separator, parser.get_quote(), true, quoted);
+            const size_t* offsets = scanner.offsets();
+
+            if (count == 0 || data[offsets[count - 1]] != '\n' || quoted) {
+                pending.append(data, size);
+                in_quotes = quoted;
+                return;
+            }
+
+            position = offsets[count - 1] + 1;
+            pending.append(data, position);
+            parser.parse_record(pending, separator);
+            emit();
+            pending.clear();
+            in_quotes = false;
+        }
+
+        // records that fit in the chunk are parsed in place
+        while (position < size) {
+            const std::string_view rest(data + position, size - position);
+            const size_t consumed = parser.parse_record(rest, separator);
+            if (!parser.terminated()) {
+                pending.assign(rest);
+                in_quotes = std::count(rest.begin(), rest.end(), parser.get_quote()) % 2 == 1;
+                break;
+            }
+            emit();
+            position += consumed;
+        }
+    }
+
+    void csv_stream_parser::set_quote(const char quote) {
+        parser.set_quote(quote);
+    }
+
+    void csv_stream_parser::finish() {
+        if (!pending.empty()) {
+            parser.parse_record(pending, separator);
+            emit();
+            pending.clear();
+            in_quotes = false;
+        }
+    }
+
+    void csv_stream_parser::emit() {
+        records++;
+        callback(parser);
+    }
+
+    size_t csv_stream_parser::rows() const {
+        return records;
+    }
+
+    size_t csv_stream_parser::pending_size() const {
+        return pending.size();
+    }
+
+    void csv_stream_parser::reset() {
+        pending.clear();
+        in_quotes = false;
+        records = 0;
+        parser.reset();
+    }
+
+}
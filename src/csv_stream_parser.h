@@ -0,0 +1,91 @@
+//
+// Created by Andres Jaimes on 26/07/25.
+//
+
+#ifndef CSV_STREAM_PARSER_H
+#define CSV_STREAM_PARSER_H
+
+#include <functional>
+#include <string>
+#include "csv_handler.h"
+#include "csv_parser.h"
+
+namespace sevilla {
+
+    /**
+     * Parses csv data pushed in chunks of any size, as it arrives from a pipe, a socket or
+     * an http response. Complete records are passed to a callback. Only the incomplete record
+     * at the end of a chunk is kept, so memory is bounded by the longest record.
+     */
+    class csv_stream_parser {
+
+    public:
+        /**
+         * Receives every complete record. The parser's fields are only valid during the call.
+         */
+        using record_callback = std::function<void(const csv_parser& record)>;
+
+    private:
+        csv_parser parser;
+        csv_scanner scanner;
+        record_callback callback;
+        char separator;
+
+        /**
+         * Bytes of the record that the last chunk left incomplete.
+         */
+        std::string pending;
+
+        /**
+         * Whether `pending` ends inside a quoted field.
+         */
+        bool in_quotes = false;
+
+        size_t records = 0;
+
+        void emit();
+
+    public:
+        csv_stream_parser(char separator, record_callback callback);
+
+        /**
+         * Passes every complete record to `handler`, field by field. The handler must
+         * outlive the parser.
+         */
+        csv_stream_parser(char separator, csv_handler& handler);
+
+        /**
+         * Sets the character that encloses fields. See `csv_parser::set_quote`.
+         */
+        void set_quote(char quote);
+
+        /**
+         * Parses a chunk of data, calling back for every record it completes.
+         */
+        void feed(const char* data, size_t size);
+
+        /**
+         * Signals the end of the data, calling back for a final record without a line break.
+         */
+        void finish();
+
+        /**
+         * Returns the number of records passed to the callback.
+         */
+        size_t rows() const;
+
+        /**
+         * Returns the number of bytes held for an incomplete record.
+         */
+        size_t pending_size() const;
+
+        /**
+         * Discards any incomplete record and the row count.
+         */
+        void reset();
+
+    };
+
+}
+
+#endif //CSV_STREAM_PARSER_H
@@ -0,0 +1,63 @@
+//
+// Created by Andres Jaimes on 19/07/25.
+//
+
+#include <stdexcept>
+#include "csv_table.h"
+
+namespace sevilla {
+
+    void csv_table::append(const csv_parser& record) {
+        for (size_t i = 0; i < record.size(); i++) {
+            bytes.append(record.view(i));
+            field_offsets.push_back(bytes.size());
+        }
+        row_offsets.push_back(field_offsets.size() - 1);
+    }
+
+    void csv_table::append(const std::vector<std::string_view>& row) {
+        for (const std::string_view& field : row) {
+            bytes.append(field);
+            field_offsets.push_back(bytes.size());
+        }
+        row_offsets.push_back(field_offsets.size() - 1);
+    }
+
+    size_t csv_table::rows() const {
+        return row_offsets.size() - 1;
+    }
+
+    size_t csv_table::row_size(const size_t row) const {
+        if (row >= rows()) {
+            throw std::out_of_range("Row is out of range");
+        }
+        return row_offsets[row + 1] - row_offsets[row];
+    }
+
+    std::string_view csv_table::field(const size_t row, const size_t column) const {
+        if (column >= row_size(row)) {
+            throw std::out_of_range("Column is out of range");
+        }
+        const size_t index = row_offsets[row] + column;
+        return std::string_view(bytes).substr(field_offsets[index], field_offsets[index + 1] - field_offsets[index]);
+    }
+
+    const std::string& csv_table::data() const {
+        return bytes;
+    }
+
+    const std::vector<size_t>& csv_table::fields() const {
+        return field_offsets;
+    }
+
+    const std::vector<size_t>& csv_table::row_fields() const {
+        return row_offsets;
+    }
+
+    void csv_table::clear() {
+        bytes.clear();
+        field_offsets.assign(1, 0);
+        row_offsets.assign(1, 0);
+    }
+
+}
@@ -0,0 +1,85 @@
+//
+// Created by Andres Jaimes on 19/07/25.
+//
+
+#ifndef CSV_TABLE_H
+#define CSV_TABLE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "csv_parser.h"
+
+namespace sevilla {
+
+    /**
+     * Rows of csv fields kept in flat storage: the bytes of every field one after the
+     * other, plus offset tables for fields and rows. Appending a record costs one copy
+     * of its bytes, and no allocation once the buffers have grown.
+     */
+    class csv_table {
+
+    private:
+        std::string bytes;
+
+        /**
+         * Where each field starts in `bytes`, plus the end of the last field.
+         */
+        std::vector<size_t> field_offsets{0};
+
+        /**
+         * Where each row starts in `field_offsets`, plus the end of the last row.
+         */
+        std::vector<size_t> row_offsets{0};
+
+    public:
+        /**
+         * Appends the fields of the last record parsed by `record`.
+         */
+        void append(const csv_parser& record);
+
+        /**
+         * Appends a row of fields.
+         */
+        void append(const std::vector<std::string_view>& row);
+
+        /**
+         * Returns the number of rows.
+         */
+        size_t rows() const;
+
+        /**
+         * Returns the number of fields in a row.
+         */
+        size_t row_size(size_t row) const;
+
+        /**
+         * Returns a field by row and column.
+         */
+        std::string_view field(size_t row, size_t column) const;
+
+        /**
+         * Returns the bytes of every field, one after the other.
+         */
+        const std::string& data() const;
+
+        /**
+         * Returns `fields + 1` offsets into `data()`. Field `i` spans `[offsets[i], offsets[i + 1])`.
+         */
+        const std::vector<size_t>& fields() const;
+
+        /**
+         * Returns `rows + 1` offsets into `fields()`. Row `r` holds fields `[offsets[r], offsets[r + 1])`.
+         */
+        const std::vector<size_t>& row_fields() const;
+
+        /**
+         * Removes every row, keeping the allocated memory.
+         */
+        void clear();
+
+    };
+
+}
+
+#endif //CSV_TABLE_H
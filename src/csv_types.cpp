@@ -0,0 +1,376 @@
+//
+// Created by Andres Jaimes on 02/08/25.
+//
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include "csv_types.h"
+
+#if !defined(__cpp_lib_to_chars)
+#include <cerrno>
+#include <clocale>
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+#endif
+
+namespace sevilla {
+
+    namespace {
+
+        inline bool is_digit(const char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        inline char lower(const char c) {
+            return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        bool equals_ignore_case(const std::string_view a, const std::string_view b) {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < a.size(); i++) {
+                if (lower(a[i]) != b[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Reads exactly `count` digits.
+         */
+        bool read_digits(const std::string_view s, size_t& pos, const size_t count, int& value) {
+            if (pos + count > s.size()) {
+                return false;
+            }
+            value = 0;
+            for (size_t i = 0; i < count; i++) {
+                const char c = s[pos + i];
+                if (!is_digit(c)) {
+                    return false;
+                }
+                value = value * 10 + (c - '0');
+            }
+            pos += count;
+            return true;
+        }
+
+        /**
+         * Days between 1970-01-01 and a civil date, after Howard Hinnant's algorithm.
+         */
+        int64_t days_from_civil(int64_t y, const unsigned m, const unsigned d) {
+            y -= m <= 2;
+            const int64_t era = (y >= 0 ? y : y - 399) / 400;
+            const unsigned yoe = static_cast<unsigned>(y - era * 400);
+            const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+            const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+            return era * 146097 + static_cast<int64_t>(doe) - 719468;
+        }
+
+        bool is_leap(const int y) {
+            return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+        }
+
+        int days_in_month(const int y, const int m) {
+            static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+            return m == 2 && is_leap(y) ? 29 : days[m - 1];
+        }
+
+#if !defined(__cpp_lib_to_chars)
+        /**
+         * Checks that a field only holds what from_chars would read: `[+-]digits[.digits][e[+-]digits]`,
+         * with digits on at least one side of the point, or inf, infinity, nan or nan(chars).
+         * strtod also reads hex floats, and its decimal point depends on the locale.
+         */
+        bool is_decimal_text(std::string_view field) {
+            if (!field.empty() && (field.front() == '-' || field.front() == '+')) {
+                field.remove_prefix(1);
+            }
+            if (equals_ignore_case(field, "inf") || equals_ignore_case(field, "infinity") ||
+                equals_ignore_case(field, "nan")) {
+                return true;
+            }
+            if (field.size() > 4 && equals_ignore_case(field.substr(0, 4), "nan(") && field.back() == ')') {
+                for (const char c : field.substr(4, field.size() - 5)) {
+                    if (!is_digit(c) && !(lower(c) >= 'a' && lower(c) <= 'z') && c != '_') {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            size_t pos = 0;
+            bool any_digit = false;
+            while (pos < field.size() && is_digit(field[pos])) {
+                any_digit = true;
+                pos++;
+            }
+            if (pos < field.size() && field[pos] == '.') {
+                pos++;
+                while (pos < field.size() && is_digit(field[pos])) {
+                    any_digit = true;
+                    pos++;
+                }
+            }
+            if (!any_digit) {
+                return false;
+            }
+            if (pos < field.size() && (field[pos] == 'e' || field[pos] == 'E')) {
+                pos++;
+                if (pos < field.size() && (field[pos] == '-' || field[pos] == '+')) {
+                    pos++;
+                }
+                if (pos >= field.size() || !is_digit(field[pos])) {
+                    return false;
+                }
+                while (pos < field.size() && is_digit(field[pos])) {
+                    pos++;
+                }
+            }
+            return pos == field.size();
+        }
+#endif
+
+        /**
+         * The slow path for doubles the fast path cannot convert exactly.
+         */
+        bool parse_double_fallback(std::string_view field, double& value) {
+            // from_chars does not take a leading plus sign, and a second sign is never valid
+            if (field.size() > 1 && field.front() == '+' && field[1] != '+' && field[1] != '-') {
+                field.remove_prefix(1);
+            }
+#if defined(__cpp_lib_to_chars)
+            const char* end = field.data() + field.size();
+            const auto [ptr, ec] = std::from_chars(field.data(), end, value);
+            return ec == std::errc() && ptr == end;
+#else
+            if (!is_decimal_text(field)) {
+                return false;
+            }
+            // strtod_l needs a terminated string
+            const std::string copy(field);
+            char* end = nullptr;
+            errno = 0;
+#if defined(_WIN32)
+            static const _locale_t c_locale = _create_locale(LC_ALL, "C");
+            const double result = _strtod_l(copy.c_str(), &end, c_locale);
+#else
+            static const locale_t c_locale = newlocale(LC_ALL_MASK, "C", static_cast<locale_t>(0));
+            const double result = strtod_l(copy.c_str(), &end, c_locale);
+#endif
+            // from_chars rejects values that overflow, or underflow to zero
+            if (end != copy.c_str() + copy.size() || (errno == ERANGE && (result == 0 || std::isinf(result)))) {
+                return false;
+            }
+            value = result;
+            return true;
+#endif
+        }
+
+    }
+
+    bool parse_int64(std::string_view field, int64_t& value) {
+        // from_chars does not take a leading plus sign
+        if (field.size() > 1 && field.front() == '+' && is_digit(field[1])) {
+            field.remove_prefix(1);
+        }
+        const char* end = field.data() + field.size();
+        const auto [ptr, ec] = std::from_chars(field.data(), end, value);
+        return ec == std::errc() && ptr == end && !field.empty();
+    }
+
+    bool parse_double(const std::string_view field, double& value) {
+        // exact powers of ten for the fast path
+        static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        size_t pos = 0;
+        bool negative = false;
+        if (pos < field.size() && (field[pos] == '-' || field[pos] == '+')) {
+            negative = field[pos] == '-';
+            pos++;
+        }
+
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        bool any_digit = false;
+
+        while (pos < field.size() && is_digit(field[pos])) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(field[pos] - '0');
+                if (mantissa != 0) {
+                    digits++;
+                }
+            } else {
+                exponent++;
+            }
+            any_digit = true;
+            pos++;
+        }
+        if (pos < field.size() && field[pos] == '.') {
+            pos++;
+            while (pos < field.size() && is_digit(field[pos])) {
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(field[pos] - '0');
+                    if (mantissa != 0) {
+                        digits++;
+                    }
+                    exponent--;
+                }
+                any_digit = true;
+                pos++;
+            }
+        }
+        if (!any_digit) {
+            return parse_double_fallback(field, value);
+        }
+        if (pos < field.size() && (field[pos] == 'e' || field[pos] == 'E')) {
+            pos++;
+            bool negative_exponent = false;
+            if (pos < field.size() && (field[pos] == '-' || field[pos] == '+')) {
+                negative_exponent = field[pos] == '-';
+                pos++;
+            }
+            if (pos >= field.size()) {
+                return false;
+            }
+            int e = 0;
+            while (pos < field.size() && is_digit(field[pos])) {
+                if (e < 100000) {
+                    e = e * 10 + (field[pos] - '0');
+                }
+                pos++;
+            }
+            exponent += negative_exponent ? -e : e;
+        }
+        if (pos != field.size()) {
+            return false;
+        }
+
+        // Clinger's fast path: a mantissa and a power of ten that are both exact doubles
+        // give a correctly rounded product or quotient.
+        if (digits < 19 && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+            double result = static_cast<double>(mantissa);
+            result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+            value = negative ? -result : result;
+            return true;
+        }
+
+        return parse_double_fallback(field, value);
+    }
+
+    bool parse_bool(const std::string_view field, bool& value) {
+        if (equals_ignore_case(field, "true") || equals_ignore_case(field, "t") ||
+            equals_ignore_case(field, "yes") || equals_ignore_case(field, "y") || field == "1") {
+            value = true;
+            return true;
+        }
+        if (equals_ignore_case(field, "false") || equals_ignore_case(field, "f") ||
+            equals_ignore_case(field, "no") || equals_ignore_case(field, "n") || field == "0") {
+            value = false;
+            return true;
+        }
+        return false;
+    }
+
+    bool parse_timestamp(const std::string_view field, int64_t& value) {
+        size_t pos = 0;
+        int year, month, day;
+
+        if (!read_digits(field, pos, 4, year) || pos >= field.size() || field[pos++] != '-' ||
+            !read_digits(field, pos, 2, month) || pos >= field.size() || field[pos++] != '-' ||
+            !read_digits(field, pos, 2, day)) {
+            return false;
+        }
+        if (month < 1 || month > 12 || day < 1 || day > days_in_month(year, month)) {
+            return false;
+        }
+
+        int64_t micros = 0;
+        int64_t offset_seconds = 0;
+
+        if (pos < field.size()) {
+            if (field[pos] != 'T' && field[pos] != 't' && field[pos] != ' ') {
+                return false;
+            }
+            pos++;
+
+            int hour, minute, second = 0;
+            if (!read_digits(field, pos, 2, hour) || pos >= field.size() || field[pos++] != ':' ||
+                !read_digits(field, pos, 2, minute)) {
+                return false;
+            }
+            if (pos < field.size() && field[pos] == ':') {
+                pos++;
+                if (!read_digits(field, pos, 2, second)) {
+                    return false;
+                }
+                if (pos < field.size() && field[pos] == '.') {
+                    pos++;
+                    int64_t fraction = 0;
+                    int fraction_digits = 0;
+                    while (pos < field.size() && is_digit(field[pos])) {
+                        // digits past microseconds are dropped
+                        if (fraction_digits < 6) {
+                            fraction = fraction * 10 + (field[pos] - '0');
+                            fraction_digits++;
+                        }
+                        pos++;
+                    }
+                    if (fraction_digits == 0) {
+                        return false;
+                    }
+                    for (; fraction_digits < 6; fraction_digits++) {
+                        fraction *= 10;
+                    }
+                    micros = fraction;
+                }
+            }
+            if (hour > 23 || minute > 59 || second > 59) {
+                return false;
+            }
+            micros += (hour * 3600LL + minute * 60LL + second) * 1000000LL;
+
+            if (pos < field.size()) {
+                const char zone = field[pos++];
+                if (zone == 'Z' || zone == 'z') {
+                    if (pos != field.size()) {
+                        return false;
+                    }
+                } else if (zone == '+' || zone == '-') {
+                    int offset_hours, offset_minutes = 0;
+                    if (!read_digits(field, pos, 2, offset_hours)) {
+                        return false;
+                    }
+                    // minutes are optional, but when there is a colon they must follow it
+                    const bool colon = pos < field.size() && field[pos] == ':';
+                    if (colon) {
+                        pos++;
+                    }
+                    if ((colon || pos < field.size()) && !read_digits(field, pos, 2, offset_minutes)) {
+                        return false;
+                    }
+                    if (pos != field.size() || offset_hours > 23 || offset_minutes > 59) {
+                        return false;
+                    }
+                    offset_seconds = (offset_hours * 3600LL + offset_minutes * 60LL) * (zone == '-' ? -1 : 1);
+                } else {
+                    return false;
+                }
+            }
+        }
+
+        const int64_t days = days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+        value = days * 86400000000LL + micros - offset_seconds * 1000000LL;
+        return true;
+    }
+
+}
@@ -0,0 +1,55 @@
+//
+// Created by Andres Jaimes on 02/08/25.
+//
+
+#ifndef CSV_TYPES_H
+#define CSV_TYPES_H
+
+#include <cstdint>
+#include <string_view>
+
+namespace sevilla {
+
+    /**
+     * Column types, named after their Arrow counterparts.
+     * Timestamps are microseconds since the Unix epoch, in UTC.
+     */
+    enum class csv_type {
+        utf8 = 0,
+        int64 = 1,
+        float64 = 2,
+        boolean = 3,
+        timestamp = 4
+    };
+
+    /**
+     * Locale-independent conversions from raw field bytes. The whole field must match,
+     * surrounding whitespace included, and `value` is only written on success.
+     */
+
+    /**
+     * Parses a decimal integer with an optional sign.
+     */
+    bool parse_int64(std::string_view field, int64_t& value);
+
+    /**
+     * Parses a decimal floating point number, with an optional exponent. Accepts `inf` and `nan`.
+     */
+    bool parse_double(std::string_view field, double& value);
+
+    /**
+     * Parses true/false, t/f, yes/no, y/n or 1/0, ignoring case.
+     */
+    bool parse_bool(std::string_view field, bool& value);
+
+    /**
+     * Parses an ISO 8601 date (`2025-08-02`) or date and time (`2025-08-02T10:30:00.125-05:00`)
+     * into microseconds since the Unix epoch, in UTC. The separator may also be a space,
+     * offsets may be written `+hh:mm`, `+hhmm` or `+hh`, and times without an offset are
+     * taken as UTC.
+     */
+    bool parse_timestamp(std::string_view field, int64_t& value);
+
+}
+
+#endif //CSV_TYPES_H
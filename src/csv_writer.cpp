@@ -0,0 +1,137 @@
+//
+// Created by Andres Jaimes on 26/07/25.
+//
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include "csv_writer.h"
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace sevilla {
+
+    csv_writer::csv_writer(const char separator) : separator(separator) {}
+
+    csv_writer::csv_writer(const int fd, const char separator, const size_t flush_size)
+        : separator(separator), fd(fd), flush_size(flush_size) {
+        buffer.reserve(flush_size);
+    }
+
+    csv_writer::~csv_writer() {
+        try {
+            flush();
+        } catch (...) {
+            // destructors must not throw; call flush() to see write errors
+        }
+    }
+
+    void csv_writer::set_separator(const char value) {
+        separator = value;
+    }
+
+    void csv_writer::set_line_break(const std::string_view value) {
+        line_break = value;
+    }
+
+    void csv_writer::append_quoted(std::string_view field, const size_t special) {
+        buffer += quote;
+        buffer.append(field.data(), special);
+        field.remove_prefix(special);
+
+        // copy the runs between quotes in bulk, doubling every quote
+        while (!field.empty()) {
+            const void* found = std::memchr(field.data(), quote, field.size());
+            if (found == nullptr) {
+                buffer.append(field.data(), field.size());
+                break;
+            }
+            const size_t run = static_cast<const char*>(found) - field.data() + 1;
+            buffer.append(field.data(), run);
+            buffer += quote;
+            field.remove_prefix(run);
+        }
+
+        buffer += quote;
+    }
+
+    void csv_writer::write_field(const std::string_view field) {
+        if (!row_start) {
+            buffer += separator;
+        }
+        row_start = false;
+
+        const size_t special = scanner.find_special(field.data(), field.size(), separator, quote);
+        if (special == field.size()) {
+            buffer.append(field.data(), field.size());
+        } else {
+            append_quoted(field, special);
+        }
+    }
+
+    void csv_writer::end_row() {
+        buffer += line_break;
+        row_start = true;
+        records++;
+
+        if (fd >= 0 && buffer.size() >= flush_size) {
+            flush();
+        }
+    }
+
+    void csv_writer::write_row(const std::vector<std::string_view>& row) {
+        for (const std::string_view field : row) {
+            write_field(field);
+        }
+        end_row();
+    }
+
+    void csv_writer::write_row(const csv_parser& record) {
+        for (size_t i = 0; i < record.size(); i++) {
+            write_field(record.view(i));
+        }
+        end_row();
+    }
+
+    void csv_writer::flush() {
+        if (fd < 0) {
+            return;
+        }
+
+        size_t written = 0;
+        while (written < buffer.size()) {
+#if defined(_WIN32)
+            const int result = _write(fd, buffer.data() + written, static_cast<unsigned>(buffer.size() - written));
+#else
+            const ssize_t result = ::write(fd, buffer.data() + written, buffer.size() - written);
+#endif
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                buffer.erase(0, written);
+                throw std::runtime_error(std::string("Unable to write csv data: ") + std::strerror(errno));
+            }
+            written += static_cast<size_t>(result);
+        }
+        buffer.clear();
+    }
+
+    const std::string& csv_writer::data() const {
+        return buffer;
+    }
+
+    size_t csv_writer::rows() const {
+        return records;
+    }
+
+    void csv_writer::clear() {
+        buffer.clear();
+        row_start = true;
+    }
+
+}
@@ -0,0 +1,117 @@
+//
+// Created by Andres Jaimes on 26/07/25.
+//
+
+#ifndef CSV_WRITER_H
+#define CSV_WRITER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "csv_parser.h"
+#include "csv_scanner.h"
+
+namespace sevilla {
+
+    /**
+     * Writes csv records into a growable buffer, or into a file descriptor. Fields are only
+     * quoted when they contain a separator, a quote or a line break, which is checked many
+     * bytes at a time, and quotes inside them are doubled.
+     */
+    class csv_writer {
+
+    private:
+        csv_scanner scanner;
+        std::string buffer;
+        std::string line_break = "\n";
+        char separator = ',';
+        char quote = '"';
+
+        /**
+         * Destination descriptor, or -1 when records stay in `buffer`.
+         */
+        int fd = -1;
+
+        /**
+         * Buffered bytes that trigger a write to `fd`.
+         */
+        size_t flush_size = 64 * 1024;
+
+        /**
+         * Whether the next field starts a record.
+         */
+        bool row_start = true;
+
+        size_t records = 0;
+
+        void append_quoted(std::string_view field, size_t special);
+
+    public:
+        explicit csv_writer(char separator = ',');
+
+        /**
+         * Writes records to `fd`, which stays owned by the caller. Bytes are buffered and
+         * written once `flush_size` of them have accumulated, and when the writer is flushed
+         * or destroyed.
+         */
+        csv_writer(int fd, char separator, size_t flush_size = 64 * 1024);
+
+        ~csv_writer();
+
+        csv_writer(const csv_writer&) = delete;
+        csv_writer& operator=(const csv_writer&) = delete;
+
+        void set_separator(char value);
+
+        /**
+         * Sets the line break written after every record. Defaults to "\n".
+         */
+        void set_line_break(std::string_view value);
+
+        /**
+         * Appends a field to the current record.
+         */
+        void write_field(std::string_view field);
+
+        /**
+         * Ends the current record.
+         */
+        void end_row();
+
+        /**
+         * Appends a whole record.
+         */
+        void write_row(const std::vector<std::string_view>& row);
+
+        /**
+         * Appends the fields of the last record parsed by `record`.
+         */
+        void write_row(const csv_parser& record);
+
+        /**
+         * Writes the buffered bytes to the file descriptor. Throws std::runtime_error when
+         * the write fails. Does nothing when writing to a buffer.
+         */
+        void flush();
+
+        /**
+         * Returns the buffered bytes. When writing to a file descriptor, only the bytes
+         * that were not flushed yet.
+         */
+        const std::string& data() const;
+
+        /**
+         * Returns the number of records written so far.
+         */
+        size_t rows() const;
+
+        /**
+         * Drops the buffered bytes, keeping the allocated memory.
+         */
+        void clear();
+
+    };
+
+}
+
+#endif //CSV_WRITER_H
@@ -0,0 +1,51 @@
+//
+// Created by Andres Jaimes on 26/07/25.
+//
+
+#include <cstring>
+#include "c_api.h"
+#include "csv_writer.h"
+
+thread_local sevilla::csv_writer csv_writer;
+
+/**
+ * Writes `rows` records of `columns` fields each, and returns the csv text, writing its size
+ * to `length`. `fields` holds the fields row after row. `lengths` holds their sizes in the
+ * same order, or is null when every field is null-terminated. Null fields are written empty.
+ * The text stays valid until the next call on the same thread. Returns null on failure.
+ */
+extern "C" DLL_EXPORT
+const char* sv_write_csv_rows(const char* const* fields, const size_t* lengths, const size_t rows,
+                              const size_t columns, const char separator, size_t* length) {
+    if (length != nullptr) {
+        *length = 0;
+    }
+    if (fields == nullptr && rows > 0 && columns > 0) {
+        return nullptr;
+    }
+
+    try {
+        csv_writer.clear();
+        csv_writer.set_separator(separator);
+
+        for (size_t r = 0; r < rows; r++) {
+            for (size_t c = 0; c < columns; c++) {
+                const size_t i = r * columns + c;
+                const char* field = fields[i];
+                if (field == nullptr) {
+                    csv_writer.write_field({});
+                } else {
+                    csv_writer.write_field(std::string_view(field, lengths != nullptr ? lengths[i] : std::strlen(field)));
+                }
+            }
+            csv_writer.end_row();
+        }
+
+        if (length != nullptr) {
+            *length = csv_writer.data().size();
+        }
+        return csv_writer.data().c_str();
+    } catch (...) {
+        return nullptr;
+    }
+}
@@ -62,6 +62,7 @@ namespace sevilla {
         request_body.clear();
         status_code = 0;
         response_body.clear();
+        on_data = nullptr;
         error = CURLE_OK;
         error_message.clear();
     }
@@ -113,8 +114,13 @@ namespace sevilla {
 
             // Response writer
             std::string buffer;
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_body);
+            if (on_data) {
+                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, stream_callback);
+                curl_easy_setopt(curl, CURLOPT_WRITEDATA, this);
+            } else {
+                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+                curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_body);
+            }
 
             // Method
             if (method == "POST") {
@@ -5,6 +5,7 @@
 #ifndef HTTP_CLIENT_H
 #define HTTP_CLIENT_H
 
+#include <functional>
 #include <map>
 #include <sstream>
 #include <string>
@@ -28,6 +29,20 @@ namespace sevilla {
             return total_size;
         }
 
+        /**
+         * Support function for passing the response body to `on_data` as it arrives.
+         * Returning less than the given size makes cURL abort the transfer.
+         */
+        static size_t stream_callback(const char* contents, size_t size, size_t nmemb, http_client* client) {
+            const size_t total_size = size * nmemb;
+            try {
+                client->on_data(contents, total_size);
+            } catch (...) {
+                return 0;
+            }
+            return total_size;
+        }
+
     public:
         std::string url;
         std::string method;
@@ -42,6 +57,11 @@ namespace sevilla {
         std::string request_body;
         int status_code = 0;
         std::string response_body;
+        /*
+         * When set, the response body is passed here in pieces as it arrives,
+         * instead of being stored in response_body.
+         */
+        std::function<void(const char* data, size_t size)> on_data;
         int error;
         std::string error_message;
 
@@ -2,11 +2,53 @@
 // Created by Andres Jaimes on 28/06/25.
 //
 
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
 #include <string>
 #include "utils.h"
 
 namespace sevilla {
 
+    namespace {
+
+        constexpr uint64_t high_bits = 0x8080808080808080ULL;
+
+        void append_utf8(const uint32_t code, std::string& out) {
+            if (code < 0x80) {
+                out += static_cast<char>(code);
+            } else if (code < 0x800) {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            } else if (code < 0x10000) {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (code >> 18));
+                out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+
+        void append_wide(const uint32_t code, std::wstring& out) {
+            if (code >= 0x10000 && sizeof(wchar_t) == 2) {
+                out += static_cast<wchar_t>(0xD800 + ((code - 0x10000) >> 10));
+                out += static_cast<wchar_t>(0xDC00 + ((code - 0x10000) & 0x3FF));
+            } else {
+                out += static_cast<wchar_t>(code);
+            }
+        }
+
+        bool continuation(const unsigned char c) {
+            return (c & 0xC0) == 0x80;
+        }
+
+    }
+
     std::string slugify(const std::string& input) {
         std::string result;
         bool wasSeparator = true; // Used to avoid multiple consecutive hyphens
@@ -49,4 +91,93 @@ namespace sevilla {
         return ltrim(rtrim(s));
     }
 
+    void utf8_to_wide(const std::string_view text, std::wstring& out) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+        const size_t size = text.size();
+        out.reserve(out.size() + size);
+
+        size_t i = 0;
+        while (i < size) {
+            // copy ascii 8 bytes at a time
+            if (i + 8 <= size) {
+                uint64_t word;
+                std::memcpy(&word, bytes + i, 8);
+                if ((word & high_bits) == 0) {
+                    out.append(bytes + i, bytes + i + 8);
+                    i += 8;
+                    continue;
+                }
+            }
+
+            const unsigned char lead = bytes[i];
+            uint32_t code;
+            size_t length;
+            if (lead < 0x80) {
+                code = lead;
+                length = 1;
+            } else if (lead >= 0xC2 && lead <= 0xDF) {
+                code = lead & 0x1F;
+                length = 2;
+            } else if (lead >= 0xE0 && lead <= 0xEF) {
+                code = lead & 0x0F;
+                length = 3;
+            } else if (lead >= 0xF0 && lead <= 0xF4) {
+                code = lead & 0x07;
+                length = 4;
+            } else {
+                throw std::invalid_argument("Invalid utf-8 data");
+            }
+
+            if (i + length > size) {
+                throw std::invalid_argument("Invalid utf-8 data");
+            }
+            for (size_t k = 1; k < length; k++) {
+                if (!continuation(bytes[i + k])) {
+                    throw std::invalid_argument("Invalid utf-8 data");
+                }
+                code = (code << 6) | (bytes[i + k] & 0x3F);
+            }
+
+            // reject overlong forms, surrogates and code points past U+10FFFF
+            if ((length == 3 && code < 0x800) || (length == 4 && (code < 0x10000 || code > 0x10FFFF))
+                || (code >= 0xD800 && code <= 0xDFFF)) {
+                throw std::invalid_argument("Invalid utf-8 data");
+            }
+
+            append_wide(code, out);
+            i += length;
+        }
+    }
+
+    void wide_to_utf8(const std::wstring_view text, std::string& out) {
+        const size_t size = text.size();
+        out.reserve(out.size() + size);
+
+        size_t i = 0;
+        while (i < size) {
+            // copy ascii 4 characters at a time
+            if (i + 4 <= size && (static_cast<uint32_t>(text[i]) | static_cast<uint32_t>(text[i + 1])
+                                  | static_cast<uint32_t>(text[i + 2]) | static_cast<uint32_t>(text[i + 3])) < 0x80) {
+                const char ascii[4] = {static_cast<char>(text[i]), static_cast<char>(text[i + 1]),
+                                       static_cast<char>(text[i + 2]), static_cast<char>(text[i + 3])};
+                out.append(ascii, 4);
+                i += 4;
+                continue;
+            }
+
+            uint32_t code = static_cast<uint32_t>(text[i++]);
+            if (code >= 0xD800 && code <= 0xDBFF) {
+                const uint32_t low = i < size ? static_cast<uint32_t>(text[i]) : 0;
+                if (low < 0xDC00 || low > 0xDFFF) {
+                    throw std::invalid_argument("Invalid utf-16 data");
+                }
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                i++;
+            } else if ((code >= 0xDC00 && code <= 0xDFFF) || code > 0x10FFFF) {
+                throw std::invalid_argument("Invalid utf-16 data");
+            }
+            append_utf8(code, out);
+        }
+    }
+
 }
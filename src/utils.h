@@ -5,6 +5,9 @@
 #ifndef SLUGIFIER_H
 #define SLUGIFIER_H
 
+#include <string>
+#include <string_view>
+
 namespace sevilla {
 
     std::string slugify(const std::string& input);
@@ -13,6 +16,19 @@ namespace sevilla {
     std::string rtrim(const std::string& s);
     std::string trim(const std::string& s);
 
+    /**
+     * Transcoders between utf-8 and wide strings, for the `_w` functions of the C API.
+     * Wide strings are utf-16 where `wchar_t` has 16 bits, as on Windows, and utf-32 where
+     * it has 32; surrogate pairs are accepted in both. Both append to `out`, so a buffer can
+     * be reused, and throw std::invalid_argument on malformed input. Ascii runs are copied
+     * 8 bytes or 4 wide characters at a time with plain integer checks; there is no SIMD
+     * transcoder, and other characters are converted one code point at a time.
+     */
+
+    void utf8_to_wide(std::string_view text, std::wstring& out);
+
+    void wide_to_utf8(std::wstring_view text, std::string& out);
+
 }
 
 #endif //SLUGIFIER_H
@@ -2,8 +2,6 @@
 // Created by Andres Jaimes on 28/06/25.
 //
 
-#include <locale>
-#include <codecvt>
 #include "c_api.h"
 #include "utils.h"
 
@@ -29,15 +27,15 @@ const wchar_t* sv_slugify_w(const wchar_t* input) {
         return converted.c_str();
     }
 
-    // utf-8/utf-16 converter
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+    thread_local std::string u8_input;
     try {
-        const std::wstring ws_input = std::wstring(input);
-        // convert to std::string assuming utf-8
-        const std::string u8_input = converter.to_bytes(ws_input);
-        converted = converter.from_bytes(sv_slugify(u8_input.c_str()));
+        u8_input.clear();
+        sevilla::wide_to_utf8(input, u8_input);
+        converted.clear();
+        sevilla::utf8_to_wide(sv_slugify(u8_input.c_str()), converted);
     } catch (...) {
-        converted = converter.from_bytes(make_error("UTF conversion exception"));
+        converted.clear();
+        sevilla::utf8_to_wide(make_error("UTF conversion exception"), converted);
     }
 
     return converted.c_str();
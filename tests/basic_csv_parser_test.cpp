@@ -0,0 +1,106 @@
+//
+// Created by Andres Jaimes on 06/09/25.
+//
+
+#include <random>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/basic_csv_parser.h"
+#include "../src/csv_parser.h"
+
+namespace {
+
+    std::string random_csv(std::mt19937& random, const size_t size, const char separator) {
+        const char alphabet[] = {'a', 'b', separator, separator, '"', '"', '\n', '\r', ' '};
+        std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 1);
+        std::string data(size, ' ');
+        for (char& c : data) {
+            c = alphabet[pick(random)];
+        }
+        return data;
+    }
+
+    /**
+     * Checks that a specialized parser splits random data like the runtime parser.
+     */
+    template <class Parser>
+    void agrees_with_csv_parser(const sevilla::csv_scanner::engine engine) {
+        std::mt19937 random(2025);
+        Parser fixed(engine);
+        sevilla::csv_parser runtime;
+
+        for (size_t size = 0; size < 200; size++) {
+            for (int repeat = 0; repeat < 4; repeat++) {
+                const std::string data = random_csv(random, size, Parser::separator);
+
+                REQUIRE(fixed.parse_line_view(data) == runtime.parse_line_view(data, Parser::separator));
+                for (size_t i = 0; i < fixed.size(); i++) {
+                    REQUIRE(fixed.view(i) == runtime.view(i));
+                }
+
+                size_t position = 0;
+                while (position < data.size()) {
+                    const std::string_view rest = std::string_view(data).substr(position);
+                    const size_t consumed = fixed.parse_record(rest);
+                    REQUIRE(consumed == runtime.parse_record(rest, Parser::separator));
+                    REQUIRE(fixed.terminated() == runtime.terminated());
+                    REQUIRE(fixed.views().size() == runtime.size());
+                    for (size_t i = 0; i < fixed.size(); i++) {
+                        REQUIRE(fixed.view(i) == runtime.view(i));
+                    }
+                    position += consumed;
+                }
+            }
+        }
+    }
+
+}
+
+TEST_CASE("basic csv parser", "[csv][basic]") {
+
+    SECTION("basic csv parser splits fields at compile-time separators") {
+        sevilla::semicolon_csv_parser parser;
+
+        REQUIRE(parser.parse_line_view(R"(a;"b;""c""";,d)") == 3);
+        REQUIRE(parser.view(0) == "a");
+        REQUIRE(parser.view(1) == R"(b;"c")");
+        REQUIRE(parser.view(2) == ",d");
+        REQUIRE_THROWS_AS(parser.view(3), std::out_of_range);
+    }
+
+    SECTION("basic csv parser reads records with quoted line breaks") {
+        sevilla::comma_csv_parser parser;
+        const std::string data = "a,\"b\nc\"\r\nd";
+
+        REQUIRE(parser.parse_record(data) == 9);
+        REQUIRE(parser.terminated());
+        REQUIRE(parser.view(1) == "b\nc");
+        REQUIRE(parser.parse_record(std::string_view(data).substr(9)) == 1);
+        REQUIRE_FALSE(parser.terminated());
+        REQUIRE(parser.view(0) == "d");
+    }
+
+    SECTION("basic csv parser trims fields outside quotes") {
+        for (const auto engine : {sevilla::csv_scanner::engine::scalar, sevilla::csv_scanner::best_engine()}) {
+            sevilla::basic_csv_parser<',', '\'', true> parser(engine);
+
+            REQUIRE(parser.parse_line_view(" a ,\t' b ' , c") == 3);
+            REQUIRE(parser.view(0) == "a");
+            REQUIRE(parser.view(1) == " b ");
+            REQUIRE(parser.view(2) == "c");
+        }
+    }
+
+    SECTION("basic csv parser agrees with csv parser") {
+        for (const auto engine : {sevilla::csv_scanner::engine::scalar,
+                                  sevilla::csv_scanner::engine::sse2,
+                                  sevilla::csv_scanner::engine::avx2}) {
+            if (!sevilla::csv_scanner::supported(engine)) {
+                continue;
+            }
+            agrees_with_csv_parser<sevilla::comma_csv_parser>(engine);
+            agrees_with_csv_parser<sevilla::tab_csv_parser>(engine);
+            agrees_with_csv_parser<sevilla::semicolon_csv_parser>(engine);
+            agrees_with_csv_parser<sevilla::pipe_csv_parser>(engine);
+        }
+    }
+}
@@ -0,0 +1,204 @@
+//
+// Created by Andres Jaimes on 18/10/25.
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/basic_csv_parser.h"
+#include "../src/csv_arena.h"
+#include "../src/csv_parser.h"
+#include "../src/csv_reader.h"
+
+// every allocation of the test binary goes through here, so parsing can be checked to make none
+namespace {
+
+    std::atomic<size_t> allocations{0};
+
+}
+
+void* operator new(const size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* data = std::malloc(size == 0 ? 1 : size)) {
+        return data;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* data) noexcept {
+    std::free(data);
+}
+
+void operator delete(void* data, size_t) noexcept {
+    std::free(data);
+}
+
+namespace {
+
+    /**
+     * Rows of different widths, with escaped quotes, so fields are unescaped into the arena.
+     */
+    std::string make_rows(const size_t rows) {
+        std::string data;
+        for (size_t i = 0; i < rows; i++) {
+            data += std::to_string(i) + ",\"say \"\"" + std::string(i % 50, 'x') + "\"\"\",plain";
+            data += i % 3 == 0 ? ",\"a\"\"b\"\n" : "\n";
+        }
+        return data;
+    }
+
+}
+
+TEST_CASE("csv arena", "[csv][arena]") {
+
+    SECTION("csv arena keeps allocations in place across blocks") {
+        sevilla::csv_arena arena(16);
+        char* first = arena.allocate(10);
+        std::memcpy(first, "0123456789", 10);
+        char* second = arena.allocate(20);
+        std::memcpy(second, "abcdefghijklmnopqrst", 20);
+
+        REQUIRE(std::string(first, 10) == "0123456789");
+        REQUIRE(std::string(second, 20) == "abcdefghijklmnopqrst");
+        REQUIRE(arena.size() == 30);
+        REQUIRE(arena.capacity() == 16 + 32);
+    }
+
+    SECTION("csv arena merges its blocks on reset") {
+        sevilla::csv_arena arena(16);
+        arena.allocate(10);
+        arena.allocate(20);
+        arena.reset();
+
+        REQUIRE(arena.size() == 0);
+        REQUIRE(arena.capacity() == 48);
+
+        const size_t before = allocations.load();
+        char* first = arena.allocate(10);
+        char* second = arena.allocate(20);
+        const size_t after = allocations.load();
+        REQUIRE(after == before);
+        REQUIRE(second == first + 10);
+    }
+
+    SECTION("csv arena rewinds to a mark") {
+        sevilla::csv_arena arena(64);
+        arena.allocate(8);
+        const sevilla::csv_arena::mark mark = arena.position();
+        char* dropped = arena.allocate(16);
+        arena.rewind(mark);
+
+        REQUIRE(arena.size() == 8);
+        REQUIRE(arena.allocate(4) == dropped);
+    }
+
+    SECTION("csv arena moves its blocks and cannot be copied") {
+        static_assert(!std::is_copy_constructible_v<sevilla::csv_arena>);
+        static_assert(!std::is_copy_assignable_v<sevilla::csv_arena>);
+
+        sevilla::csv_arena arena(16);
+        char* data = arena.allocate(6);
+        std::memcpy(data, "fields", 6);
+
+        const sevilla::csv_arena moved(std::move(arena));
+        REQUIRE(moved.contains(data));
+        REQUIRE_FALSE(moved.contains(data + 16));
+        REQUIRE(std::memcmp(data, "fields", 6) == 0);
+    }
+
+    SECTION("csv parser makes no allocations per record once warmed up") {
+        const std::string data = make_rows(2000);
+        sevilla::csv_parser parser;
+
+        const auto parse_all = [&] {
+            size_t fields = 0;
+            for (size_t position = 0; position < data.size();) {
+                position += parser.parse_record(std::string_view(data).substr(position), ',');
+                fields += parser.size();
+            }
+            return fields;
+        };
+
+        const size_t fields = parse_all();
+        const size_t before = allocations.load();
+        const size_t again = parse_all();
+        const size_t after = allocations.load();
+        REQUIRE(again == fields);
+        REQUIRE(after == before);
+        REQUIRE(parser.view(1) == "say \"" + std::string(1999 % 50, 'x') + "\"");
+    }
+
+    SECTION("basic csv parser makes no allocations per record once warmed up") {
+        const std::string data = make_rows(2000);
+        sevilla::comma_csv_parser parser;
+
+        const auto parse_all = [&] {
+            size_t fields = 0;
+            for (size_t position = 0; position < data.size();) {
+                position += parser.parse_record(std::string_view(data).substr(position));
+                fields += parser.size();
+            }
+            return fields;
+        };
+
+        const size_t fields = parse_all();
+        const size_t before = allocations.load();
+        const size_t again = parse_all();
+        const size_t after = allocations.load();
+        REQUIRE(again == fields);
+        REQUIRE(after == before);
+    }
+
+    SECTION("csv reader makes no allocations per record once warmed up") {
+        const std::string data = make_rows(2000);
+        sevilla::csv_reader reader;
+        reader.open(data.data(), data.size(), ',');
+
+        size_t rows = 0;
+        while (rows < 1000 && reader.next()) {
+            rows++;
+        }
+        const size_t before = allocations.load();
+        while (reader.next()) {
+            rows++;
+        }
+        const size_t after = allocations.load();
+        REQUIRE(after == before);
+        REQUIRE(rows == 2000);
+    }
+
+    SECTION("csv parser retains fields over a batch") {
+        const std::string data = make_rows(300);
+        sevilla::csv_parser parser;
+        parser.retain_fields(true);
+
+        std::vector<std::string_view> quotes;
+        quotes.reserve(100);
+
+        size_t position = 0;
+        for (int batch = 0; batch < 3; batch++) {
+            const size_t before = allocations.load();
+            quotes.clear();
+            for (int row = 0; row < 100; row++) {
+                position += parser.parse_record(std::string_view(data).substr(position), ',');
+                quotes.push_back(parser.view(1));
+            }
+            const size_t after = allocations.load();
+
+            // every field of the batch is still readable
+            for (size_t row = 0; row < quotes.size(); row++) {
+                REQUIRE(quotes[row] == "say \"" + std::string((batch * 100 + row) % 50, 'x') + "\"");
+            }
+            // the first batch sizes the arena, and later ones are no bigger
+            if (batch > 0) {
+                REQUIRE(after == before);
+            }
+            parser.release_fields();
+        }
+    }
+}
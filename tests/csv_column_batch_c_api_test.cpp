@@ -0,0 +1,170 @@
+//
+// Created by Andres Jaimes on 09/08/25.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <dlfcn.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/json.hpp"
+
+#if defined(_WIN32)
+    #define LIBNAME "sevilla.dll"
+#elif defined(__APPLE__)
+    #define LIBNAME "libsevilla.dylib"
+#else
+    #define LIBNAME "libsevilla.so"
+#endif
+
+struct CsvColumnBatchLoaderFixture {
+
+    typedef int (*open_func)(const char*, char, int);
+    open_func csv_columns_open;
+    typedef int (*set_type_func)(size_t, int);
+    set_type_func csv_columns_set_type;
+    typedef int (*set_error_policy_func)(int);
+    set_error_policy_func csv_columns_set_error_policy;
+    typedef const char* (*errors_func)();
+    errors_func csv_columns_errors;
+    typedef size_t (*read_func)(size_t);
+    read_func csv_columns_read;
+    typedef size_t (*count_func)();
+    count_func csv_columns_count;
+    typedef int (*type_func)(size_t);
+    type_func csv_columns_type;
+    typedef size_t (*null_count_func)(size_t);
+    null_count_func csv_columns_null_count;
+    typedef const void* (*buffer_func)(size_t, int, size_t*);
+    buffer_func csv_columns_buffer;
+    typedef void (*close_func)();
+    close_func csv_columns_close;
+    void* handle = nullptr;
+
+    // load the dynamic library
+    CsvColumnBatchLoaderFixture() {
+        handle = dlopen(LIBNAME, RTLD_NOW);
+        if (handle != nullptr) {
+            csv_columns_open = reinterpret_cast<open_func>(dlsym(handle, "sv_csv_columns_open"));
+            csv_columns_set_type = reinterpret_cast<set_type_func>(dlsym(handle, "sv_csv_columns_set_type"));
+            csv_columns_set_error_policy = reinterpret_cast<set_error_policy_func>(dlsym(handle, "sv_csv_columns_set_error_policy"));
+            csv_columns_errors = reinterpret_cast<errors_func>(dlsym(handle, "sv_csv_columns_errors"));
+            csv_columns_read = reinterpret_cast<read_func>(dlsym(handle, "sv_csv_columns_read"));
+            csv_columns_count = reinterpret_cast<count_func>(dlsym(handle, "sv_csv_columns_count"));
+            csv_columns_type = reinterpret_cast<type_func>(dlsym(handle, "sv_csv_columns_type"));
+            csv_columns_null_count = reinterpret_cast<null_count_func>(dlsym(handle, "sv_csv_columns_null_count"));
+            csv_columns_buffer = reinterpret_cast<buffer_func>(dlsym(handle, "sv_csv_columns_buffer"));
+            csv_columns_close = reinterpret_cast<close_func>(dlsym(handle, "sv_csv_columns_close"));
+        }
+    }
+
+    // unload the dynamic library
+    ~CsvColumnBatchLoaderFixture() {
+        if (handle != nullptr) {
+            dlclose(handle);
+        }
+    }
+};
+
+TEST_CASE_METHOD(CsvColumnBatchLoaderFixture, "csv column batch c-api", "[csv][shared]") {
+
+    REQUIRE(handle != nullptr);
+
+    const std::string path = (std::filesystem::temp_directory_path() / "sevilla_columns_c_api.csv").string();
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "1,2.5,ann\n2,,bob\n3,0.5,\n";
+    }
+
+    SECTION("reads utf8 columns by default") {
+        REQUIRE(csv_columns_open(path.c_str(), ',', 0) == 1);
+        REQUIRE(csv_columns_read(10) == 3);
+        REQUIRE(csv_columns_count() == 3);
+        REQUIRE(csv_columns_type(0) == 0);
+
+        size_t length = 0;
+        const auto* offsets = static_cast<const int32_t*>(csv_columns_buffer(2, 1, &length));
+        REQUIRE(length == 4 * sizeof(int32_t));
+        const auto* data = static_cast<const char*>(csv_columns_buffer(2, 2, &length));
+        REQUIRE(std::string(data + offsets[0], offsets[2] - offsets[0]) == "annbob");
+        REQUIRE(csv_columns_type(3) == -1);
+        REQUIRE(csv_columns_buffer(3, 0, &length) == nullptr);
+        csv_columns_close();
+    }
+
+    SECTION("keeps every type set before the first read") {
+        REQUIRE(csv_columns_open(path.c_str(), ',', 0) == 1);
+        REQUIRE(csv_columns_set_type(0, 1) == 1);
+        REQUIRE(csv_columns_set_type(1, 2) == 1);
+        REQUIRE(csv_columns_set_type(0, 9) == 0);
+        REQUIRE(csv_columns_read(10) == 3);
+
+        REQUIRE(csv_columns_type(0) == 1);
+        REQUIRE(csv_columns_type(1) == 2);
+        REQUIRE(csv_columns_type(2) == 0);
+        REQUIRE(csv_columns_null_count(1) == 1);
+
+        size_t length = 0;
+        int64_t ids[3];
+        std::memcpy(ids, csv_columns_buffer(0, 1, &length), sizeof(ids));
+        REQUIRE(length == sizeof(ids));
+        REQUIRE(ids[2] == 3);
+
+        double scores[3];
+        std::memcpy(scores, csv_columns_buffer(1, 1, &length), sizeof(scores));
+        REQUIRE(scores[0] == 2.5);
+        REQUIRE(scores[2] == 0.5);
+        csv_columns_close();
+    }
+
+    SECTION("skips the header") {
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << "id,score,name\n1,2.5,ann\n2,,bob\n";
+        }
+        REQUIRE(csv_columns_open(path.c_str(), ',', 1) == 1);
+        REQUIRE(csv_columns_set_type(0, 1) == 1);
+        REQUIRE(csv_columns_set_type(1, 2) == 1);
+        REQUIRE(csv_columns_read(10) == 2);
+        REQUIRE(csv_columns_null_count(0) == 0);
+        REQUIRE(csv_columns_null_count(1) == 1);
+
+        size_t length = 0;
+        int64_t ids[2];
+        std::memcpy(ids, csv_columns_buffer(0, 1, &length), sizeof(ids));
+        REQUIRE(length == sizeof(ids));
+        REQUIRE(ids[0] == 1);
+
+        const auto* offsets = static_cast<const int32_t*>(csv_columns_buffer(2, 1, &length));
+        const auto* data = static_cast<const char*>(csv_columns_buffer(2, 2, &length));
+        REQUIRE(std::string(data + offsets[0], offsets[2] - offsets[0]) == "annbob");
+        csv_columns_close();
+    }
+
+    SECTION("reports malformed records") {
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << "1,a\n2\n3,c\n";
+        }
+        REQUIRE(csv_columns_open(path.c_str(), ',', 0) == 1);
+        REQUIRE(csv_columns_set_error_policy(1) == 1);
+        REQUIRE(csv_columns_set_error_policy(7) == 0);
+        REQUIRE(csv_columns_read(10) == 2);
+
+        const nlohmann::json j = nlohmann::json::parse(csv_columns_errors());
+        REQUIRE(j["ragged_rows"] == 1);
+        REQUIRE(j["skipped_rows"] == 1);
+        REQUIRE(j["last_error"]["row"] == 1);
+        csv_columns_set_error_policy(0);
+        csv_columns_close();
+    }
+
+    SECTION("fails on missing files") {
+        REQUIRE(csv_columns_open(nullptr, ',', 0) == 0);
+        REQUIRE(csv_columns_open("/no/such/sevilla.csv", ',', 0) == 0);
+    }
+
+    std::filesystem::remove(path);
+}
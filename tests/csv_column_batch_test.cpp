@@ -0,0 +1,76 @@
+//
+// Created by Andres Jaimes on 09/08/25.
+//
+
+#include <cstring>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_column_batch.h"
+
+namespace {
+
+    bool bit(const sevilla::csv_buffer& bitmap, const size_t index) {
+        return (bitmap.data()[index / 8] >> (index % 8)) & 1;
+    }
+
+    template <class T>
+    T value(const sevilla::csv_buffer& values, const size_t index) {
+        T result;
+        std::memcpy(&result, values.data() + index * sizeof(T), sizeof(T));
+        return result;
+    }
+
+}
+
+TEST_CASE("csv column batch", "[csv][columns]") {
+
+    const char data[] = "a,1,2.5,true\nbb,,x,false\n\"c\"\"\",3,-1,\n";
+    sevilla::csv_reader reader;
+    sevilla::csv_column_batch batch;
+    reader.open(data, sizeof(data) - 1, ',');
+
+    SECTION("csv column batch builds utf8 columns") {
+        REQUIRE(batch.read(reader, 10) == 3);
+        REQUIRE(batch.columns() == 4);
+
+        const sevilla::csv_column& column = batch.column(0);
+        REQUIRE(column.type == sevilla::csv_type::utf8);
+        REQUIRE(value<int32_t>(column.offsets, 0) == 0);
+        REQUIRE(value<int32_t>(column.offsets, 1) == 1);
+        REQUIRE(value<int32_t>(column.offsets, 2) == 3);
+        REQUIRE(value<int32_t>(column.offsets, 3) == 5);
+        REQUIRE(std::string(reinterpret_cast<const char*>(column.data.data()), column.data.size()) == "abbc\"");
+        REQUIRE(column.null_count == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(column.offsets.data()) % 64 == 0);
+    }
+
+    SECTION("csv column batch converts typed columns") {
+        batch.set_types({sevilla::csv_type::utf8, sevilla::csv_type::int64,
+                         sevilla::csv_type::float64, sevilla::csv_type::boolean});
+        batch.read(reader, 10);
+
+        const sevilla::csv_column& integers = batch.column(1);
+        REQUIRE(value<int64_t>(integers.values, 0) == 1);
+        REQUIRE(value<int64_t>(integers.values, 2) == 3);
+        REQUIRE_FALSE(bit(integers.validity, 1));
+        REQUIRE(integers.null_count == 1);
+
+        const sevilla::csv_column& doubles = batch.column(2);
+        REQUIRE(value<double>(doubles.values, 0) == 2.5);
+        REQUIRE(value<double>(doubles.values, 2) == -1);
+        REQUIRE_FALSE(bit(doubles.validity, 1));
+
+        const sevilla::csv_column& booleans = batch.column(3);
+        REQUIRE(bit(booleans.values, 0));
+        REQUIRE_FALSE(bit(booleans.values, 1));
+        REQUIRE(bit(booleans.validity, 1));
+        REQUIRE_FALSE(bit(booleans.validity, 2));
+    }
+
+    SECTION("csv column batch reads in batches") {
+        REQUIRE(batch.read(reader, 2) == 2);
+        REQUIRE(batch.read(reader, 2) == 1);
+        REQUIRE(value<int32_t>(batch.column(0).offsets, 1) == 2);
+        REQUIRE(batch.read(reader, 2) == 0);
+        REQUIRE(batch.columns() == 0);
+    }
+}
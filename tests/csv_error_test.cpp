@@ -0,0 +1,158 @@
+//
+// Created by Andres Jaimes on 04/10/25.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_error.h"
+#include "../src/csv_reader.h"
+
+namespace {
+
+    const std::string malformed =
+        "id,name,score\n"
+        "1,\"Ann\",10\n"
+        "2,B\"o\"b,20\n"           // stray quotes inside an unquoted field
+        "3,\"Cy\"x,30\n"           // text after a closing quote
+        "4,Di\n"                   // short row
+        "5,\"Ed \"\"E\"\"\",50,9\n"  // long row
+        "6,Flo,60\r\n"
+        "7,\"Gus,70\n";            // the quote is never closed
+
+}
+
+TEST_CASE("csv errors", "[csv][error]") {
+
+    const sevilla::csv_validator validator;
+    size_t fields = 0;
+    sevilla::csv_error error;
+
+    SECTION("csv validator accepts well-formed records") {
+        for (const std::string record : {"a,b,c\n", "\"a\",\"b,\"\"c\"\"\",\"\"\r\n", ",,", "a\rb,c", ""}) {
+            REQUIRE(validator.check(record, ',', '"', fields, error));
+        }
+        REQUIRE(validator.check("a,\"b\nc\",d\n", ',', '"', fields, error));
+        REQUIRE(fields == 3);
+        REQUIRE(validator.check("", ',', '"', fields, error));
+        REQUIRE(fields == 1);
+        REQUIRE(validator.check("'a;b';c", ';', '\'', fields, error));
+        REQUIRE(fields == 2);
+    }
+
+    SECTION("csv validator locates quote errors") {
+        REQUIRE_FALSE(validator.check("a,b\"c,d\n", ',', '"', fields, error));
+        REQUIRE(error.kind == sevilla::csv_error_kind::stray_quote);
+        REQUIRE(error.offset == 3);
+        REQUIRE(error.column == 1);
+
+        REQUIRE_FALSE(validator.check("\"a\"b,c", ',', '"', fields, error));
+        REQUIRE(error.kind == sevilla::csv_error_kind::stray_quote);
+        REQUIRE(error.offset == 2);
+        REQUIRE(error.column == 0);
+
+        REQUIRE_FALSE(validator.check("a,b,\"c\nd\n", ',', '"', fields, error));
+        REQUIRE(error.kind == sevilla::csv_error_kind::unterminated_quote);
+        REQUIRE(error.offset == 4);
+        REQUIRE(error.column == 2);
+    }
+
+    SECTION("csv reader is lenient by default") {
+        sevilla::csv_reader reader;
+        reader.open(malformed.data(), malformed.size(), ',');
+
+        size_t rows = 0;
+        while (reader.next()) {
+            rows++;
+        }
+        REQUIRE(rows == 8);
+        REQUIRE(reader.errors().total() == 0);
+    }
+
+    SECTION("csv reader skips malformed records") {
+        sevilla::csv_reader reader;
+        reader.set_error_policy(sevilla::csv_error_policy::skip);
+        reader.open(malformed.data(), malformed.size(), ',');
+        reader.read_header();
+
+        std::vector<std::string> ids;
+        while (reader.next()) {
+            ids.emplace_back(reader.view("id"));
+        }
+        REQUIRE(ids == std::vector<std::string>{"1", "6"});
+        REQUIRE(reader.row() == 8);
+
+        const sevilla::csv_error_counts& counts = reader.errors();
+        REQUIRE(counts.stray_quotes == 2);
+        REQUIRE(counts.ragged_rows == 2);
+        REQUIRE(counts.unterminated_quotes == 1);
+        REQUIRE(counts.skipped_rows == 5);
+        REQUIRE(counts.total() == 5);
+
+        const sevilla::csv_error& last = reader.last_error();
+        REQUIRE(last.kind == sevilla::csv_error_kind::unterminated_quote);
+        REQUIRE(last.row == 7);
+        REQUIRE(last.column == 1);
+        REQUIRE(last.offset == malformed.rfind('"'));
+    }
+
+    SECTION("csv reader pads ragged records") {
+        sevilla::csv_reader reader;
+        reader.set_error_policy(sevilla::csv_error_policy::pad);
+        reader.open(malformed.data(), malformed.size(), ',');
+        reader.read_header();
+
+        std::vector<size_t> sizes;
+        while (reader.next()) {
+            sizes.push_back(reader.size());
+            if (reader.view(0) == "4") {
+                REQUIRE(reader.view(2).empty());
+                REQUIRE(reader["score"].empty());
+            }
+            if (reader.view(0) == "5") {
+                REQUIRE(reader.view(1) == "Ed \"E\"");
+                REQUIRE(reader.view(2) == "50");
+            }
+        }
+        REQUIRE(sizes == std::vector<size_t>{3, 3, 3, 3, 3, 3, 2});
+        // the last record is reported for its quote, and kept as it was read
+        REQUIRE(reader.errors().ragged_rows == 2);
+        REQUIRE(reader.errors().total() == 5);
+        REQUIRE(reader.errors().skipped_rows == 0);
+    }
+
+    SECTION("csv reader stops at malformed records and resumes after them") {
+        sevilla::csv_reader reader;
+        reader.set_error_policy(sevilla::csv_error_policy::abort);
+        reader.open(malformed.data(), malformed.size(), ',');
+        reader.read_header();
+
+        REQUIRE(reader.next());
+        try {
+            reader.next();
+            FAIL("Expected a csv_format_error");
+        } catch (const sevilla::csv_format_error& e) {
+            REQUIRE(e.error().kind == sevilla::csv_error_kind::stray_quote);
+            REQUIRE(e.error().row == 2);
+            REQUIRE(e.error().column == 1);
+            REQUIRE(e.error().offset == malformed.find("B\"o") + 1);
+            REQUIRE(std::string(e.what()) == e.error().message());
+        }
+        REQUIRE_THROWS_AS(reader.next(), sevilla::csv_format_error);
+        REQUIRE_THROWS_AS(reader.next(), sevilla::csv_format_error);
+        REQUIRE_THROWS_AS(reader.next(), sevilla::csv_format_error);
+        REQUIRE(reader.next());
+        REQUIRE(reader.view(0) == "6");
+        REQUIRE(reader.errors().total() == 4);
+    }
+
+    SECTION("csv reader checks records read in parallel") {
+        sevilla::csv_reader reader;
+        reader.set_error_policy(sevilla::csv_error_policy::skip);
+        reader.open(malformed.data(), malformed.size(), ',');
+
+        const std::vector<sevilla::csv_table> tables = reader.read_parallel(4);
+        REQUIRE(tables.size() == 1);
+        REQUIRE(tables[0].rows() == 3);
+        REQUIRE(reader.errors().skipped_rows == 5);
+    }
+
+}
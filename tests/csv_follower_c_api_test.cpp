@@ -0,0 +1,126 @@
+//
+// Created by Andres Jaimes on 11/10/25.
+//
+
+#include <dlfcn.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/json.hpp"
+
+#if defined(_WIN32)
+    #define LIBNAME "sevilla.dll"
+#elif defined(__APPLE__)
+    #define LIBNAME "libsevilla.dylib"
+#else
+    #define LIBNAME "libsevilla.so"
+#endif
+
+struct CsvFollowerLoaderFixture {
+
+    typedef int (*open_func)(const char*, char, size_t);
+    open_func csv_follow_open;
+    typedef size_t (*poll_func)(int);
+    poll_func csv_follow_poll;
+    typedef size_t (*offset_func)();
+    offset_func csv_follow_offset;
+    typedef const char* (*data_func)(size_t*);
+    data_func csv_follow_data;
+    typedef const size_t* (*field_offsets_func)(size_t*);
+    field_offsets_func csv_follow_field_offsets;
+    typedef const size_t* (*row_offsets_func)();
+    row_offsets_func csv_follow_row_offsets;
+    typedef const char* (*error_func)();
+    error_func csv_follow_error;
+    typedef void (*close_func)();
+    close_func csv_follow_close;
+    void* handle = nullptr;
+
+    // load the dynamic library
+    CsvFollowerLoaderFixture() {
+        handle = dlopen(LIBNAME, RTLD_NOW);
+        if (handle != nullptr) {
+            csv_follow_open = reinterpret_cast<open_func>(dlsym(handle, "sv_csv_follow_open"));
+            csv_follow_poll = reinterpret_cast<poll_func>(dlsym(handle, "sv_csv_follow_poll"));
+            csv_follow_offset = reinterpret_cast<offset_func>(dlsym(handle, "sv_csv_follow_offset"));
+            csv_follow_data = reinterpret_cast<data_func>(dlsym(handle, "sv_csv_follow_data"));
+            csv_follow_field_offsets = reinterpret_cast<field_offsets_func>(dlsym(handle, "sv_csv_follow_field_offsets"));
+            csv_follow_row_offsets = reinterpret_cast<row_offsets_func>(dlsym(handle, "sv_csv_follow_row_offsets"));
+            csv_follow_error = reinterpret_cast<error_func>(dlsym(handle, "sv_csv_follow_error"));
+            csv_follow_close = reinterpret_cast<close_func>(dlsym(handle, "sv_csv_follow_close"));
+        }
+    }
+
+    // unload the dynamic library
+    ~CsvFollowerLoaderFixture() {
+        if (handle != nullptr) {
+            dlclose(handle);
+        }
+    }
+};
+
+TEST_CASE_METHOD(CsvFollowerLoaderFixture, "csv follower c-api", "[csv][shared]") {
+
+    REQUIRE(handle != nullptr);
+
+    SECTION("polls appended records in batches") {
+        const std::string path = (std::filesystem::temp_directory_path() / "sevilla_follower_c_api_test.csv").string();
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << "a,bb\nccc,";
+        }
+
+        REQUIRE(csv_follow_open(path.c_str(), ',', 0) == 1);
+        REQUIRE(csv_follow_poll(0) == 1);
+        REQUIRE(csv_follow_offset() == 5);
+
+        size_t length = 0;
+        size_t fields = 0;
+        const char* data = csv_follow_data(&length);
+        const size_t* offsets = csv_follow_field_offsets(&fields);
+        REQUIRE(std::string(data, length) == "abb");
+        REQUIRE(fields == 2);
+        REQUIRE(offsets[1] == 1);
+        REQUIRE(csv_follow_row_offsets()[1] == 2);
+
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::app);
+            file << "d\n";
+        }
+        REQUIRE(csv_follow_poll(1000) == 1);
+        REQUIRE(csv_follow_error() == nullptr);
+        data = csv_follow_data(&length);
+        REQUIRE(std::string(data, length) == "cccd");
+
+        csv_follow_close();
+        std::filesystem::remove(path);
+    }
+
+    SECTION("reports missing files") {
+        REQUIRE(csv_follow_open("/nonexistent/sevilla.csv", ',', 0) == 0);
+        REQUIRE(nlohmann::json::parse(csv_follow_error()).contains("error"));
+        REQUIRE(csv_follow_open(nullptr, ',', 0) == 0);
+        REQUIRE(csv_follow_poll(0) == 0);
+        REQUIRE(csv_follow_error() == nullptr);
+    }
+
+    SECTION("reports failed polls") {
+        const std::string path = (std::filesystem::temp_directory_path() / "sevilla_follower_c_api_error.csv").string();
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << "a,b\nc,d\n";
+        }
+        REQUIRE(csv_follow_open(path.c_str(), ',', 0) == 1);
+        REQUIRE(csv_follow_poll(0) == 2);
+
+        // a truncated file is read again from the start, which fails once it is gone
+        std::filesystem::resize_file(path, 0);
+        std::filesystem::remove(path);
+        REQUIRE(csv_follow_poll(0) == 0);
+        const nlohmann::json j = nlohmann::json::parse(csv_follow_error());
+        REQUIRE(j["error"].get<std::string>().find("Unable to open file") == 0);
+        csv_follow_close();
+    }
+
+}
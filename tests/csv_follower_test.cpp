@@ -0,0 +1,115 @@
+//
+// Created by Andres Jaimes on 11/10/25.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_follower.h"
+
+namespace {
+
+    void append(const std::string& path, const std::string& text) {
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        file << text;
+    }
+
+}
+
+TEST_CASE("csv follower", "[csv][follower]") {
+
+    const std::string path = (std::filesystem::temp_directory_path() / "sevilla_follower_test.csv").string();
+    std::filesystem::remove(path);
+    append(path, "id,name\n1,one\n2,t");
+
+    sevilla::csv_follower follower;
+    sevilla::csv_table table;
+    follower.open(path, ',');
+
+    SECTION("csv follower holds back a record until it is complete") {
+        REQUIRE(follower.read(table) == 2);
+        REQUIRE(table.field(1, 1) == "one");
+        REQUIRE(follower.offset() == 14);
+
+        table.clear();
+        REQUIRE(follower.read(table) == 0);
+
+        append(path, "wo\n3,\"th\nree\"");
+        REQUIRE(follower.read(table) == 1);
+        REQUIRE(table.field(0, 1) == "two");
+        REQUIRE(follower.offset() == 20);
+
+        append(path, "\n");
+        REQUIRE(follower.read(table) == 1);
+        REQUIRE(table.field(1, 1) == "th\nree");
+        REQUIRE(follower.offset() == 31);
+        REQUIRE(follower.rows() == 4);
+    }
+
+    SECTION("csv follower resumes from a saved offset") {
+        follower.read(table);
+        const size_t offset = follower.offset();
+        follower.close();
+
+        append(path, "wo\n3,three\n");
+        follower.open(path, ',', offset);
+        table.clear();
+        REQUIRE(follower.read(table) == 2);
+        REQUIRE(table.field(0, 0) == "2");
+        REQUIRE(table.field(1, 1) == "three");
+    }
+
+    SECTION("csv follower waits for appended records") {
+        follower.read(table);
+        table.clear();
+
+        const auto start = std::chrono::steady_clock::now();
+        REQUIRE_FALSE(follower.wait(100));
+        REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(90));
+
+        std::thread writer([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            append(path, "wo\n");
+        });
+        REQUIRE(follower.poll(table, 5000) == 1);
+        writer.join();
+        REQUIRE(table.field(0, 1) == "two");
+    }
+
+    SECTION("csv follower starts over when the file is truncated or replaced") {
+        follower.read(table);
+
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << "9\n";
+        }
+        table.clear();
+        REQUIRE(follower.read(table) == 1);
+        REQUIRE(table.field(0, 0) == "9");
+
+        const std::string rotated = path + ".1";
+        std::filesystem::rename(path, rotated);
+        append(rotated, "10\n");
+        append(path, "a,b\n");
+
+        table.clear();
+        REQUIRE(follower.wait(0));
+        REQUIRE(follower.read(table) == 2);
+        REQUIRE(table.field(0, 0) == "10");
+        REQUIRE(table.field(1, 1) == "b");
+        REQUIRE(follower.offset() == 4);
+        std::filesystem::remove(rotated);
+    }
+
+    SECTION("csv follower reports missing files") {
+        REQUIRE_THROWS_AS(follower.open(path + ".missing", ','), std::runtime_error);
+        REQUIRE(follower.read(table) == 0);
+        REQUIRE_FALSE(follower.wait(10));
+    }
+
+    follower.close();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,63 @@
+//
+// Created by Andres Jaimes on 13/09/25.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_handler.h"
+#include "../src/csv_stream_parser.h"
+
+namespace {
+
+    /**
+     * Writes events as text: fields as `row:column=value`, row ends as `|`.
+     */
+    class recording_handler : public sevilla::csv_handler {
+
+    public:
+        std::string events;
+
+        void on_field(const size_t row, const size_t column, const char* data, const size_t size) override {
+            events += std::to_string(row) + ":" + std::to_string(column) + "=" + std::string(data, size) + " ";
+        }
+
+        void on_row_end(size_t /* row */) override {
+            events += "|";
+        }
+
+    };
+
+}
+
+TEST_CASE("csv handler", "[csv][handler]") {
+
+    sevilla::csv_parser parser;
+    recording_handler handler;
+
+    SECTION("csv handler receives every field and row end") {
+        const std::string data = "a,\"b\"\"c\"\n\"d\ne\",f\r\n";
+
+        REQUIRE(sevilla::parse_csv(parser, data, ',', handler) == 2);
+        REQUIRE(handler.events == "0:0=a 0:1=b\"c |1:0=d\ne 1:1=f |");
+    }
+
+    SECTION("csv handler honors the parser's projection and filters") {
+        const std::string data = "1,x,keep\n2,y,drop\n3,z,keep";
+        parser.select({1, 0});
+        parser.add_filter(sevilla::csv_predicate::equals(2, "keep"));
+
+        REQUIRE(sevilla::parse_csv(parser, data, ',', handler) == 2);
+        REQUIRE(handler.events == "0:0=x 0:1=1 |1:0=z 1:1=3 |");
+    }
+
+    SECTION("csv handler receives streamed records") {
+        sevilla::csv_stream_parser stream(';', handler);
+        const std::string data = "a;\"b\nc\"\nd;e\n";
+        for (const char c : data) {
+            stream.feed(&c, 1);
+        }
+        stream.finish();
+
+        REQUIRE(stream.rows() == 2);
+        REQUIRE(handler.events == "0:0=a 0:1=b\nc |1:0=d 1:1=e |");
+    }
+}
@@ -0,0 +1,52 @@
+//
+// Created by Andres Jaimes on 16/08/25.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_parser.h"
+
+TEST_CASE("csv header", "[csv][header]") {
+
+    SECTION("csv header resolves names to indexes") {
+        const sevilla::csv_header header({"id", "name", "", "id", "total"});
+
+        REQUIRE(header.size() == 5);
+        REQUIRE(header.find("id") == 0);
+        REQUIRE(header.find("name") == 1);
+        REQUIRE(header.find("") == 2);
+        REQUIRE(header.find("total") == 4);
+        REQUIRE(header.find("missing") == sevilla::csv_header::npos);
+        REQUIRE(header.name(3) == "id");
+        REQUIRE(sevilla::csv_header().find("id") == sevilla::csv_header::npos);
+    }
+
+    SECTION("csv header handles many columns") {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < 1000; i++) {
+            names.push_back("column_" + std::to_string(i));
+        }
+        const sevilla::csv_header header(std::vector<std::string_view>(names.begin(), names.end()));
+
+        for (size_t i = 0; i < names.size(); i++) {
+            REQUIRE(header.find(names[i]) == i);
+        }
+    }
+
+    SECTION("csv parser looks fields up by name") {
+        sevilla::csv_parser parser;
+        parser.parse_line("customer_id,amount", ',');
+        parser.set_header();
+        parser.parse_line(R"(17,"1,5")", ',');
+
+        REQUIRE(parser["customer_id"] == "17");
+        REQUIRE(parser.view("amount") == "1,5");
+        REQUIRE(parser.column("amount") == 1);
+        REQUIRE(parser[1] == "1,5");
+        REQUIRE_THROWS_AS(parser["missing"], std::out_of_range);
+
+        parser.reset();
+        parser.parse_line("18", ',');
+        REQUIRE(parser.view("customer_id") == "18");
+        REQUIRE_THROWS_AS(parser.view("amount"), std::out_of_range);
+    }
+}
@@ -0,0 +1,138 @@
+//
+// Created by Andres Jaimes on 09/08/25.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_reader.h"
+
+namespace {
+
+    /**
+     * Row `r` starts with `r`, and every third row has a quoted field with a line break.
+     */
+    std::string make_data(const size_t rows) {
+        std::string data;
+        for (size_t r = 0; r < rows; r++) {
+            data += std::to_string(r);
+            data += r % 3 == 0 ? ",\"two\nlines, \"\"quoted\"\"\"\n" : ",plain\r\n";
+        }
+        return data;
+    }
+
+}
+
+TEST_CASE("csv index", "[csv][index]") {
+
+    const std::string data = make_data(1000);
+    sevilla::csv_reader reader;
+    reader.open(data.data(), data.size(), ',');
+
+    SECTION("csv index counts records, not lines") {
+        const sevilla::csv_index index = reader.build_index(64);
+
+        REQUIRE(index.rows() == 1000);
+        REQUIRE(index.size() == data.size());
+        REQUIRE(index.checkpoint(0) == 0);
+        REQUIRE(data.compare(index.checkpoint(640), 4, "640,") == 0);
+        REQUIRE(index.checkpoint(703) == index.checkpoint(640));
+        REQUIRE_THROWS_AS(index.checkpoint(1000), std::out_of_range);
+    }
+
+    SECTION("csv index handles empty lines and a missing final line break") {
+        sevilla::csv_index index(1);
+        const std::string text = "a\n\n\"b\nc\"";
+        index.build(text.data(), text.size());
+
+        REQUIRE(index.rows() == 3);
+        REQUIRE(index.checkpoint(1) == 2);
+        REQUIRE(index.checkpoint(2) == 3);
+    }
+
+    SECTION("csv reader seeks to any row") {
+        const sevilla::csv_index index = reader.build_index(100);
+
+        for (const size_t row : {0, 1, 99, 100, 101, 555, 999}) {
+            reader.seek(index, row);
+            REQUIRE(reader.next());
+            REQUIRE(reader.view(0) == std::to_string(row));
+            REQUIRE(reader.row() == row + 1);
+        }
+
+        reader.seek(index, 1000);
+        REQUIRE_FALSE(reader.next());
+        REQUIRE_THROWS_AS(reader.seek(index, 1001), std::out_of_range);
+    }
+
+    SECTION("csv index survives a round trip through a file") {
+        const std::string path = (std::filesystem::temp_directory_path() / "sevilla_index.idx").string();
+        reader.build_index(10).save(path);
+
+        sevilla::csv_index loaded;
+        loaded.load(path);
+        REQUIRE(loaded.rows() == 1000);
+        REQUIRE(loaded.get_stride() == 10);
+
+        reader.seek(loaded, 321);
+        REQUIRE(reader.next());
+        REQUIRE(reader.view(0) == "321");
+        std::filesystem::remove(path);
+    }
+
+    SECTION("csv index checks the stored count against the file size") {
+        const std::string path = (std::filesystem::temp_directory_path() / "sevilla_corrupt.idx").string();
+        {
+            // a valid header for 2^62 records, one per checkpoint, and no offsets after it
+            const uint64_t header[4] = {1, 1ULL << 62, 0, 1ULL << 62};
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write("SVCSVIX1", 8);
+            file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        }
+
+        sevilla::csv_index index;
+        REQUIRE_THROWS_AS(index.load(path), std::runtime_error);
+
+        reader.build_index(10).save(path);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+        REQUIRE_THROWS_AS(index.load(path), std::runtime_error);
+        std::filesystem::remove(path);
+    }
+
+    SECTION("csv index checks the stored offsets against the data size") {
+        const std::string path = (std::filesystem::temp_directory_path() / "sevilla_offsets.idx").string();
+        const auto write_offset = [&path](const size_t checkpoint, const uint64_t offset) {
+            // offsets follow the 8 byte signature and the 4 word header
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(8 + 4 * sizeof(uint64_t) + checkpoint * sizeof(uint64_t)));
+            file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+        };
+
+        sevilla::csv_index index;
+        reader.build_index(10).save(path);
+        write_offset(99, data.size() + 1);
+        REQUIRE_THROWS_AS(index.load(path), std::runtime_error);
+
+        reader.build_index(10).save(path);
+        write_offset(50, 0);
+        REQUIRE_THROWS_AS(index.load(path), std::runtime_error);
+
+        reader.build_index(10).save(path);
+        write_offset(99, data.size());
+        REQUIRE_NOTHROW(index.load(path));
+        std::filesystem::remove(path);
+    }
+
+    SECTION("csv index rejects foreign files and data") {
+        const std::string path = (std::filesystem::temp_directory_path() / "sevilla_not_index.idx").string();
+        std::ofstream(path) << "a,b,c\n";
+
+        sevilla::csv_index index;
+        REQUIRE_THROWS_AS(index.load(path), std::runtime_error);
+        REQUIRE_THROWS_AS(sevilla::csv_index(0), std::invalid_argument);
+
+        index.build("x\n", 2);
+        REQUIRE_THROWS_AS(reader.seek(index, 0), std::invalid_argument);
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,157 @@
+//
+// Created by Andres Jaimes on 20/09/25.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <zlib.h>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_inflater.h"
+#include "../src/csv_reader.h"
+
+namespace {
+
+    /**
+     * Compresses `text` into a single gzip member.
+     */
+    std::string gzip(const std::string& text) {
+        z_stream stream{};
+        if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("deflateInit2 failed");
+        }
+
+        std::string result(deflateBound(&stream, text.size()) + 32, '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+        stream.avail_in = static_cast<uInt>(text.size());
+        stream.next_out = reinterpret_cast<Bytef*>(result.data());
+        stream.avail_out = static_cast<uInt>(result.size());
+        deflate(&stream, Z_FINISH);
+        result.resize(stream.total_out);
+        deflateEnd(&stream);
+        return result;
+    }
+
+    std::string inflate_all(sevilla::csv_inflater& inflater) {
+        std::string result;
+        std::string chunk;
+        while (inflater.next(chunk)) {
+            result += chunk;
+        }
+        return result;
+    }
+
+    /**
+     * Row `r` starts with `r`, and every fifth row has a quoted field with a line break.
+     */
+    std::string make_data(const size_t rows) {
+        std::string data = "id,text\n";
+        for (size_t r = 0; r < rows; r++) {
+            data += std::to_string(r);
+            data += r % 5 == 0 ? ",\"two\nlines, \"\"quoted\"\"\"\n" : ",plain text\r\n";
+        }
+        return data;
+    }
+
+}
+
+TEST_CASE("csv inflater", "[csv][inflater]") {
+
+    const std::string data = make_data(20000);
+    const std::string compressed = gzip(data);
+
+    SECTION("csv inflater recognizes gzip data") {
+        REQUIRE(sevilla::csv_inflater::is_gzip(compressed.data(), compressed.size()));
+        REQUIRE_FALSE(sevilla::csv_inflater::is_gzip(data.data(), data.size()));
+        REQUIRE_FALSE(sevilla::csv_inflater::is_gzip(compressed.data(), 1));
+        REQUIRE_FALSE(sevilla::csv_inflater::is_gzip(nullptr, 0));
+    }
+
+    SECTION("csv inflater inflates in bounded chunks") {
+        sevilla::csv_inflater inflater(compressed.data(), compressed.size(), 1000, 2);
+
+        std::string result;
+        std::string chunk;
+        while (inflater.next(chunk)) {
+            REQUIRE(chunk.size() <= 1000);
+            result += chunk;
+        }
+        REQUIRE(result == data);
+        REQUIRE_FALSE(inflater.next(chunk));
+    }
+
+    SECTION("csv inflater reads concatenated members") {
+        const std::string members = gzip("a,b\n") + gzip("c,d\n") + gzip("e,f\n");
+        sevilla::csv_inflater inflater(members.data(), members.size());
+
+        REQUIRE(inflate_all(inflater) == "a,b\nc,d\ne,f\n");
+    }
+
+    SECTION("csv inflater rejects truncated and invalid data") {
+        sevilla::csv_inflater truncated(compressed.data(), compressed.size() / 2);
+        REQUIRE_THROWS_AS(inflate_all(truncated), std::runtime_error);
+
+        std::string corrupted = compressed;
+        corrupted[3] = '\xff';
+        sevilla::csv_inflater invalid(corrupted.data(), corrupted.size());
+        REQUIRE_THROWS_AS(inflate_all(invalid), std::runtime_error);
+    }
+
+    SECTION("csv inflater stops when destroyed early") {
+        sevilla::csv_inflater inflater(compressed.data(), compressed.size(), 64, 1);
+        std::string chunk;
+        REQUIRE(inflater.next(chunk));
+    }
+
+    SECTION("csv reader reads gzip data transparently") {
+        sevilla::csv_reader reader;
+        reader.open(compressed.data(), compressed.size(), ',');
+        reader.read_header();
+
+        size_t rows = 0;
+        size_t last_offset = 0;
+        while (reader.next()) {
+            REQUIRE(reader.view("id") == std::to_string(rows));
+            REQUIRE(reader.view("text") == (rows % 5 == 0 ? "two\nlines, \"quoted\"" : "plain text"));
+            REQUIRE(data.compare(reader.offset(), std::to_string(rows).size(), std::to_string(rows)) == 0);
+            REQUIRE(reader.offset() >= last_offset);
+            last_offset = reader.offset();
+            rows++;
+        }
+        REQUIRE(rows == 20000);
+        REQUIRE(reader.row() == 20001);
+    }
+
+    SECTION("csv reader filters and parses gzip files") {
+        const std::string path = (std::filesystem::temp_directory_path() / "sevilla_inflater_test.csv.gz").string();
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << compressed;
+        }
+
+        sevilla::csv_reader reader;
+        reader.open(path, ',');
+        reader.read_header();
+        reader.add_filter(sevilla::csv_predicate::prefix(0, "1999"));
+
+        size_t matches = 0;
+        while (reader.next()) {
+            REQUIRE(reader.view(0).substr(0, 4) == "1999");
+            matches++;
+        }
+        REQUIRE(matches == 11);
+
+        sevilla::csv_dialect dialect;
+        dialect.header = true;
+        reader.clear_filters();
+        reader.open(path, dialect);
+        const std::vector<sevilla::csv_table> tables = reader.read_parallel(4);
+        REQUIRE(tables.size() == 1);
+        REQUIRE(tables[0].rows() == 20000);
+        REQUIRE_THROWS_AS(reader.build_index(), std::runtime_error);
+
+        reader.close();
+        std::filesystem::remove(path);
+    }
+
+}
@@ -0,0 +1,75 @@
+//
+// Created by Andres Jaimes on 16/10/25.
+//
+
+#include <dlfcn.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/json.hpp"
+
+#if defined(_WIN32)
+    #define LIBNAME "sevilla.dll"
+#elif defined(__APPLE__)
+    #define LIBNAME "libsevilla.dylib"
+#else
+    #define LIBNAME "libsevilla.so"
+#endif
+
+struct CsvJsonWriterLoaderFixture {
+
+    typedef const char* (*convert_func)(const char*, size_t, char, int, int, size_t*);
+    convert_func csv_to_json_lines;
+    typedef const char* (*convert_file_func)(const char*, const char*, char, int, int);
+    convert_file_func csv_to_json_lines_file;
+    void* handle = nullptr;
+
+    // load the dynamic library
+    CsvJsonWriterLoaderFixture() {
+        handle = dlopen(LIBNAME, RTLD_NOW);
+        if (handle != nullptr) {
+            csv_to_json_lines = reinterpret_cast<convert_func>(dlsym(handle, "sv_csv_to_json_lines"));
+            csv_to_json_lines_file = reinterpret_cast<convert_file_func>(dlsym(handle, "sv_csv_to_json_lines_file"));
+        }
+    }
+
+    // unload the dynamic library
+    ~CsvJsonWriterLoaderFixture() {
+        if (handle != nullptr) {
+            dlclose(handle);
+        }
+    }
+};
+
+TEST_CASE_METHOD(CsvJsonWriterLoaderFixture, "csv json writer c-api", "[csv][shared]") {
+
+    REQUIRE(handle != nullptr);
+
+    SECTION("converts csv data") {
+        const std::string data = "id,name\n1,ann\n2,bob\n";
+        size_t length = 0;
+        const char* text = csv_to_json_lines(data.data(), data.size(), ',', 1, 1, &length);
+
+        REQUIRE(text != nullptr);
+        REQUIRE(std::string(text, length) == "{\"id\":1,\"name\":\"ann\"}\n{\"id\":2,\"name\":\"bob\"}\n");
+
+        text = csv_to_json_lines(data.data(), data.size(), ',', 0, 0, &length);
+        REQUIRE(std::string(text, length).rfind("{\"0\":\"id\",\"1\":\"name\"}\n", 0) == 0);
+    }
+
+    SECTION("converts csv files") {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        const std::string input = (directory / "sevilla_json_c_api_input.csv").string();
+        const std::string output = (directory / "sevilla_json_c_api_output.jsonl").string();
+        {
+            std::ofstream file(input, std::ios::binary | std::ios::trunc);
+            file << "a\n1\n2\n3\n";
+        }
+
+        REQUIRE(nlohmann::json::parse(csv_to_json_lines_file(input.c_str(), output.c_str(), ',', 1, 0))["rows"] == 3);
+        REQUIRE(nlohmann::json::parse(csv_to_json_lines_file(nullptr, output.c_str(), ',', 1, 0)).contains("error"));
+        std::filesystem::remove(input);
+        std::filesystem::remove(output);
+    }
+}
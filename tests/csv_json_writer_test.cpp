@@ -0,0 +1,117 @@
+//
+// Created by Andres Jaimes on 16/10/25.
+//
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_json_writer.h"
+#include "../src/json.hpp"
+
+TEST_CASE("csv json writer", "[csv][json]") {
+
+    sevilla::csv_json_writer writer;
+
+    SECTION("csv json writer uses keys and column numbers") {
+        writer.set_keys(std::vector<std::string_view>{"id", "name"});
+        writer.write_row({"1", "ann"});
+        writer.write_row({"2", "bob", "extra"});
+
+        REQUIRE(writer.data() == "{\"id\":\"1\",\"name\":\"ann\"}\n{\"id\":\"2\",\"name\":\"bob\",\"2\":\"extra\"}\n");
+        REQUIRE(writer.rows() == 2);
+    }
+
+    SECTION("csv json writer escapes keys and values") {
+        writer.set_keys(std::vector<std::string_view>{"a\"b"});
+        writer.write_row({std::string_view("q\"\\\n\t\x01 \xc3\xa9", 9)});
+
+        REQUIRE(writer.data() == "{\"a\\\"b\":\"q\\\"\\\\\\n\\t\\u0001 \xc3\xa9\"}\n");
+        const nlohmann::json j = nlohmann::json::parse(writer.data());
+        REQUIRE(j["a\"b"] == "q\"\\\n\t\x01 \xc3\xa9");
+    }
+
+    SECTION("csv json writer writes typed values") {
+        writer.set_keys(std::vector<std::string_view>{"i", "f", "b", "t"});
+        writer.set_types({sevilla::csv_type::int64, sevilla::csv_type::float64, sevilla::csv_type::boolean,
+                          sevilla::csv_type::timestamp});
+        writer.write_row({"-12", "2.5e3", "yes", "2025-10-16"});
+        writer.write_row({"+007", ".5", "0", ""});
+        writer.write_row({"", "inf", "", "x"});
+        writer.write_row({"n/a", "1.", "maybe", "x"});
+
+        REQUIRE(writer.data() ==
+            "{\"i\":-12,\"f\":2.5e3,\"b\":true,\"t\":\"2025-10-16\"}\n"
+            "{\"i\":7,\"f\":0.5,\"b\":false,\"t\":\"\"}\n"
+            "{\"i\":null,\"f\":null,\"b\":null,\"t\":\"x\"}\n"
+            "{\"i\":\"n/a\",\"f\":1,\"b\":\"maybe\",\"t\":\"x\"}\n");
+    }
+
+    SECTION("csv json writer clears its data and row count") {
+        writer.write_row({"1", std::string(100, 'x')});
+        writer.clear();
+
+        REQUIRE(writer.data().empty());
+        REQUIRE(writer.rows() == 0);
+
+        writer.write_row({"2"});
+        REQUIRE(writer.data() == "{\"0\":\"2\"}\n");
+        REQUIRE(writer.data().data()[writer.data().size()] == '\0');
+        REQUIRE(writer.rows() == 1);
+    }
+
+    SECTION("csv json writer flushes to a file as its buffer fills") {
+        const std::string path = (std::filesystem::temp_directory_path() / "sevilla_json_flush.jsonl").string();
+        std::string expected;
+        {
+            FILE* file = std::fopen(path.c_str(), "wb");
+            REQUIRE(file != nullptr);
+            {
+                sevilla::csv_json_writer small(fileno(file), 16);
+                for (int i = 0; i < 100; i++) {
+                    const std::string value(i % 7, 'v');
+                    small.write_row({std::to_string(i), value});
+                    expected += "{\"0\":\"" + std::to_string(i) + "\",\"1\":\"" + value + "\"}\n";
+                    REQUIRE(small.data().size() < 16);
+                }
+                REQUIRE(small.rows() == 100);
+            }
+            std::fclose(file);
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream text;
+        text << file.rdbuf();
+        REQUIRE(text.str() == expected);
+        file.close();
+        std::filesystem::remove(path);
+    }
+
+    SECTION("csv json writer converts files") {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        const std::string input = (directory / "sevilla_json_input.csv").string();
+        const std::string output = (directory / "sevilla_json_output.jsonl").string();
+        {
+            std::ofstream file(input, std::ios::binary | std::ios::trunc);
+            file << "id;note\n1;\"a;\nb\"\n2;c\n";
+        }
+
+        sevilla::csv_dialect dialect;
+        dialect.separator = ';';
+        dialect.header = true;
+        REQUIRE(sevilla::csv_to_json_lines(input, output, dialect, true) == 2);
+
+        std::ifstream file(output, std::ios::binary);
+        std::stringstream text;
+        text << file.rdbuf();
+        REQUIRE(text.str() == "{\"id\":1,\"note\":\"a;\\nb\"}\n{\"id\":2,\"note\":\"c\"}\n");
+
+        REQUIRE_THROWS_AS(sevilla::csv_to_json_lines((directory / "sevilla_json_missing.csv").string(), output),
+                          std::runtime_error);
+        REQUIRE_THROWS_AS(sevilla::csv_to_json_lines(input, input, dialect), std::invalid_argument);
+        REQUIRE(std::filesystem::file_size(input) == 21);
+        std::filesystem::remove(input);
+        std::filesystem::remove(output);
+    }
+}
@@ -0,0 +1,220 @@
+//
+// Created by Andres Jaimes on 02/08/25.
+//
+
+#include <dlfcn.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <cwchar>
+#include <catch2/catch_test_macros.hpp>
+
+#if defined(_WIN32)
+    #define LIBNAME "sevilla.dll"
+#elif defined(__APPLE__)
+    #define LIBNAME "libsevilla.dylib"
+#else
+    #define LIBNAME "libsevilla.so"
+#endif
+
+struct CsvLoaderFixture {
+
+    typedef size_t (*parse_func)(const char*, char);
+    parse_func parse_csv_line;
+    parse_func csv_set_header;
+    typedef const char* (*field_func)(size_t);
+    field_func csv_field;
+    typedef size_t (*parse_w_func)(const wchar_t*, wchar_t);
+    parse_w_func parse_csv_line_w;
+    typedef const wchar_t* (*field_w_func)(size_t);
+    field_w_func csv_field_w;
+    typedef const char* (*by_name_func)(const char*);
+    by_name_func csv_field_by_name;
+    typedef void (*filter_func)(size_t, const char*);
+    filter_func csv_filter_equals;
+    typedef void (*clear_func)();
+    clear_func csv_clear_filters;
+    typedef void (*field_callback)(size_t, size_t, const char*, size_t, void*);
+    typedef void (*row_callback)(size_t, void*);
+    typedef size_t (*events_func)(const char*, size_t, char, field_callback, row_callback, void*);
+    events_func parse_csv_events;
+    typedef int (*int64_func)(size_t, int64_t*);
+    int64_func csv_field_int64;
+    typedef int (*double_func)(size_t, double*);
+    double_func csv_field_double;
+    typedef size_t (*batch_func)(const char*, size_t, char, size_t);
+    batch_func parse_csv_batch;
+    typedef size_t (*consumed_func)();
+    consumed_func csv_batch_consumed;
+    typedef const char* (*batch_data_func)(size_t*);
+    batch_data_func csv_batch_data;
+    typedef const size_t* (*field_offsets_func)(size_t*);
+    field_offsets_func csv_batch_field_offsets;
+    typedef const size_t* (*row_offsets_func)();
+    row_offsets_func csv_batch_row_offsets;
+    void* handle = nullptr;
+
+    // load the dynamic library
+    CsvLoaderFixture() {
+        handle = dlopen(LIBNAME, RTLD_NOW);
+        if (handle != nullptr) {
+            parse_csv_line = reinterpret_cast<parse_func>(dlsym(handle, "sv_parse_csv_line"));
+            csv_field = reinterpret_cast<field_func>(dlsym(handle, "sv_csv_field"));
+            parse_csv_line_w = reinterpret_cast<parse_w_func>(dlsym(handle, "sv_parse_csv_line_w"));
+            csv_field_w = reinterpret_cast<field_w_func>(dlsym(handle, "sv_csv_field_w"));
+            csv_field_by_name = reinterpret_cast<by_name_func>(dlsym(handle, "sv_csv_field_by_name"));
+            csv_set_header = reinterpret_cast<parse_func>(dlsym(handle, "sv_csv_set_header"));
+            csv_filter_equals = reinterpret_cast<filter_func>(dlsym(handle, "sv_csv_filter_equals"));
+            csv_clear_filters = reinterpret_cast<clear_func>(dlsym(handle, "sv_csv_clear_filters"));
+            parse_csv_events = reinterpret_cast<events_func>(dlsym(handle, "sv_parse_csv_events"));
+            csv_field_int64 = reinterpret_cast<int64_func>(dlsym(handle, "sv_csv_field_int64"));
+            csv_field_double = reinterpret_cast<double_func>(dlsym(handle, "sv_csv_field_double"));
+            parse_csv_batch = reinterpret_cast<batch_func>(dlsym(handle, "sv_parse_csv_batch"));
+            csv_batch_consumed = reinterpret_cast<consumed_func>(dlsym(handle, "sv_csv_batch_consumed"));
+            csv_batch_data = reinterpret_cast<batch_data_func>(dlsym(handle, "sv_csv_batch_data"));
+            csv_batch_field_offsets = reinterpret_cast<field_offsets_func>(dlsym(handle, "sv_csv_batch_field_offsets"));
+            csv_batch_row_offsets = reinterpret_cast<row_offsets_func>(dlsym(handle, "sv_csv_batch_row_offsets"));
+        }
+    }
+
+    // unload the dynamic library
+    ~CsvLoaderFixture() {
+        if (handle != nullptr) {
+            dlclose(handle);
+        }
+    }
+};
+
+TEST_CASE_METHOD(CsvLoaderFixture, "csv parser c-api", "[csv][shared]") {
+
+    REQUIRE(handle != nullptr);
+
+    SECTION("parses a line into fields") {
+        REQUIRE(parse_csv_line(R"(one,"t""wo",three)", ',') == 3);
+        REQUIRE(strcmp(csv_field(0), "one") == 0);
+        REQUIRE(strcmp(csv_field(1), R"(t"wo)") == 0);
+        REQUIRE(strcmp(csv_field(2), "three") == 0);
+        REQUIRE(csv_field(3) == nullptr);
+    }
+
+    SECTION("parses wide lines") {
+        REQUIRE(parse_csv_line_w(L"caf\u00e9,\"a,\U0001F600\",\u20ac", L',') == 3);
+        REQUIRE(strcmp(csv_field(0), "caf\xC3\xA9") == 0);
+        REQUIRE(strcmp(csv_field(1), "a,\xF0\x9F\x98\x80") == 0);
+        // narrow fields are terminated in place, past the closing quote and the separator
+        REQUIRE(csv_field(2) == csv_field(1) + strlen(csv_field(1)) + 2);
+
+        const wchar_t* first = csv_field_w(0);
+        REQUIRE(wcscmp(first, L"caf\u00e9") == 0);
+        REQUIRE(wcscmp(csv_field_w(1), L"a,\U0001F600") == 0);
+        REQUIRE(wcscmp(csv_field_w(2), L"\u20ac") == 0);
+        REQUIRE(csv_field_w(0) == first);
+        REQUIRE(csv_field_w(3) == nullptr);
+
+        // narrow lines are converted on demand too
+        REQUIRE(parse_csv_line("x,y", ',') == 2);
+        REQUIRE(wcscmp(csv_field_w(1), L"y") == 0);
+
+        REQUIRE(parse_csv_line_w(L"a\u00e9b", static_cast<wchar_t>(0xe9)) == 0);
+        REQUIRE(parse_csv_line_w(nullptr, L',') == 0);
+        REQUIRE(csv_field_w(0) == nullptr);
+    }
+
+    SECTION("correctly handles a null value") {
+        REQUIRE(parse_csv_line(nullptr, ',') == 0);
+        REQUIRE(csv_field(0) == nullptr);
+    }
+
+    SECTION("looks fields up by header name") {
+        REQUIRE(csv_set_header("id,name", ',') == 2);
+        parse_csv_line("7,seven", ',');
+
+        REQUIRE(strcmp(csv_field_by_name("name"), "seven") == 0);
+        REQUIRE(strcmp(csv_field_by_name("id"), "7") == 0);
+        REQUIRE(csv_field_by_name("missing") == nullptr);
+        REQUIRE(csv_field_by_name(nullptr) == nullptr);
+        REQUIRE(csv_set_header(nullptr, ',') == 0);
+    }
+
+    SECTION("converts typed fields") {
+        parse_csv_line("12,2.5,x", ',');
+        int64_t i = 0;
+        double d = 0;
+
+        REQUIRE(csv_field_int64(0, &i) == 1);
+        REQUIRE(i == 12);
+        REQUIRE(csv_field_double(1, &d) == 1);
+        REQUIRE(d == 2.5);
+        REQUIRE(csv_field_int64(2, &i) == 0);
+        REQUIRE(csv_field_int64(9, &i) == 0);
+    }
+
+}
+
+TEST_CASE_METHOD(CsvLoaderFixture, "csv batch c-api", "[csv][shared]") {
+
+    REQUIRE(handle != nullptr);
+
+    const std::string data = "a,b\n\"c\nd\",e\r\nf";
+
+    SECTION("parses many records per call") {
+        REQUIRE(parse_csv_batch(data.data(), data.size(), ',', 0) == 3);
+        REQUIRE(csv_batch_consumed() == data.size());
+
+        size_t length = 0;
+        const char* bytes_data = csv_batch_data(&length);
+        const std::string bytes(bytes_data, length);
+        REQUIRE(bytes == "abc\ndef");
+
+        size_t fields = 0;
+        const size_t* field_offsets = csv_batch_field_offsets(&fields);
+        REQUIRE(fields == 5);
+        REQUIRE(field_offsets[2] == 2);
+        REQUIRE(field_offsets[3] == 5);
+
+        const size_t* row_offsets = csv_batch_row_offsets();
+        REQUIRE(row_offsets[0] == 0);
+        REQUIRE(row_offsets[1] == 2);
+        REQUIRE(row_offsets[2] == 4);
+        REQUIRE(row_offsets[3] == 5);
+    }
+
+    SECTION("leaves filtered records out") {
+        csv_filter_equals(1, "e");
+        REQUIRE(parse_csv_batch(data.data(), data.size(), ',', 0) == 1);
+        REQUIRE(csv_batch_consumed() == data.size());
+        csv_clear_filters();
+    }
+
+    SECTION("stops after max rows") {
+        REQUIRE(parse_csv_batch(data.data(), data.size(), ',', 1) == 1);
+        REQUIRE(csv_batch_consumed() == 4);
+    }
+
+    SECTION("correctly handles a null value") {
+        REQUIRE(parse_csv_batch(nullptr, 10, ',', 0) == 0);
+    }
+
+}
+
+TEST_CASE_METHOD(CsvLoaderFixture, "csv events c-api", "[csv][shared]") {
+
+    REQUIRE(handle != nullptr);
+
+    SECTION("calls back for every field and row") {
+        const std::string data = "a,\"b,c\"\nd,e\n";
+        std::string events;
+        const auto on_field = [](size_t row, size_t column, const char* data, size_t size, void* user_data) {
+            *static_cast<std::string*>(user_data) += std::to_string(row) + std::to_string(column) + std::string(data, size) + " ";
+        };
+        const auto on_row_end = [](size_t /* row */, void* user_data) {
+            *static_cast<std::string*>(user_data) += "|";
+        };
+
+        REQUIRE(parse_csv_events(data.data(), data.size(), ',', on_field, on_row_end, &events) == 2);
+        REQUIRE(events == "00a 01b,c |10d 11e |");
+        REQUIRE(parse_csv_events(data.data(), data.size(), ',', nullptr, nullptr, nullptr) == 2);
+        REQUIRE(parse_csv_events(nullptr, 0, ',', on_field, on_row_end, &events) == 0);
+    }
+
+}
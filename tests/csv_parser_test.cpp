@@ -2,12 +2,62 @@
 // Created by Andres Jaimes on 25/06/25.
 //
 
+#include <memory>
+#include <random>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include "../src/csv_parser.h"
 
+namespace {
+
+    // the original byte-at-a-time parser, kept as a reference for the scanning engines
+    std::vector<std::string> reference_parse(const std::string& line, const char separator) {
+        std::vector<std::string> fields;
+        std::string field;
+        bool in_quotes = false;
+
+        for (size_t i = 0; i < line.size(); i++) {
+            const char c = line[i];
+            if (in_quotes) {
+                if (c == '"') {
+                    if (i + 1 < line.size() && line[i + 1] == '"') {
+                        field += '"';
+                        i++;
+                    } else {
+                        in_quotes = false;
+                    }
+                } else {
+                    field += c;
+                }
+            } else {
+                if (c == '"') {
+                    in_quotes = true;
+                } else if (c == separator) {
+                    fields.push_back(field);
+                    field.clear();
+                } else {
+                    field += c;
+                }
+            }
+        }
+
+        fields.push_back(field);
+        return fields;
+    }
+
+}
+
 TEST_CASE("csv parser", "[csv]") {
 
-    sevilla::csv_parser parser;
+    // every case runs once per scanning engine the cpu supports
+    const auto engine = GENERATE(sevilla::csv_scanner::engine::scalar,
+                                 sevilla::csv_scanner::engine::sse2,
+                                 sevilla::csv_scanner::engine::avx2);
+    if (!sevilla::csv_scanner::supported(engine)) {
+        return;
+    }
+
+    sevilla::csv_parser parser(engine);
 
     SECTION("csv parser splits a simple line") {
         size_t total = parser.parse_line("one,two,three", ',');
@@ -74,4 +124,147 @@ TEST_CASE("csv parser", "[csv]") {
 
         REQUIRE_THROWS_AS(parser[3], std::out_of_range);
     }
+
+    SECTION("csv parser view mode returns spans into the line") {
+        const std::string line = R"(one,"two",three)";
+        size_t total = parser.parse_line_view(line, ',');
+
+        REQUIRE(total == 3);
+        REQUIRE(parser.view(0) == "one");
+        REQUIRE(parser.view(1) == "two");
+        REQUIRE(parser.view(2) == "three");
+        REQUIRE(parser.view(0).data() == line.data());
+        REQUIRE(parser.view(1).data() == line.data() + 5);
+    }
+
+    SECTION("csv parser view mode unescapes quoted fields") {
+        const std::string line = R"(a,"say ""hi""",x"y"z)";
+        size_t total = parser.parse_line_view(line, ',');
+
+        REQUIRE(total == 3);
+        REQUIRE(parser.view(1) == R"(say "hi")");
+        REQUIRE(parser.view(2) == "xyz");
+        REQUIRE(parser[1] == R"(say "hi")");
+    }
+
+    SECTION("csv parser keeps separators inside quotes") {
+        size_t total = parser.parse_line(R"("a,b",c)", ',');
+
+        REQUIRE(total == 2);
+        REQUIRE(parser[0] == "a,b");
+        REQUIRE(parser[1] == "c");
+    }
+
+    SECTION("csv parser fields are null-terminated after parse_line") {
+        parser.parse_line(R"(one,"t""wo",three)", ',');
+
+        REQUIRE(std::string(parser.c_str(0)) == "one");
+        REQUIRE(std::string(parser.c_str(1)) == R"(t"wo)");
+        REQUIRE(std::string(parser.c_str(2)) == "three");
+    }
+
+    SECTION("csv parser copies keep their fields after the source is gone") {
+        const std::string long_field(100, 'x');
+        auto source = std::make_unique<sevilla::csv_parser>();
+        source->parse_line("a,\"b\"\"c\"," + long_field, ',');
+
+        sevilla::csv_parser copy(*source);
+        sevilla::csv_parser assigned;
+        assigned = *source;
+        source.reset();
+
+        for (const sevilla::csv_parser* p : {&copy, &assigned}) {
+            REQUIRE(p->size() == 3);
+            REQUIRE((*p)[0] == "a");
+            REQUIRE(std::string(p->c_str(1)) == "b\"c");
+            REQUIRE((*p)[2] == long_field);
+        }
+    }
+
+    SECTION("csv parser moves keep the fields of short lines") {
+        // a short line is stored inside the string, so moving it changes its address
+        parser.parse_line("a,\"b\"\"c\",d", ',');
+        sevilla::csv_parser moved(std::move(parser));
+
+        REQUIRE(moved.size() == 3);
+        REQUIRE(std::string(moved.c_str(0)) == "a");
+        REQUIRE(moved.view(1) == "b\"c");
+        REQUIRE(std::string(moved.c_str(2)) == "d");
+
+        sevilla::csv_parser assigned;
+        assigned = std::move(moved);
+        REQUIRE(assigned[0] == "a");
+        REQUIRE(assigned[2] == "d");
+        REQUIRE(moved.size() == 0);
+    }
+
+    SECTION("csv parser reads one record at a time") {
+        const std::string data = "a,\"b\nc\"\r\nd";
+        size_t consumed = parser.parse_record(data, ',');
+
+        REQUIRE(consumed == 9);
+        REQUIRE(parser.terminated());
+        REQUIRE(parser.size() == 2);
+        REQUIRE(parser.view(1) == "b\nc");
+
+        consumed = parser.parse_record(std::string_view(data).substr(consumed), ',');
+
+        REQUIRE(consumed == 1);
+        REQUIRE_FALSE(parser.terminated());
+        REQUIRE(parser.view(0) == "d");
+    }
+
+    SECTION("csv parser converts typed fields") {
+        parser.parse_line("42,-1.5,true,2025-08-02,abc", ',');
+
+        REQUIRE(parser.get_int64(0) == 42);
+        REQUIRE(parser.get_double(1) == -1.5);
+        REQUIRE(parser.get_bool(2));
+        REQUIRE(parser.get_timestamp(3) == 1754092800000000LL);
+        REQUIRE_THROWS_AS(parser.get_int64(4), std::invalid_argument);
+        REQUIRE_THROWS_AS(parser.get_double(5), std::out_of_range);
+    }
+
+    SECTION("csv parser keeps only the selected columns") {
+        parser.select({3, 1});
+        size_t total = parser.parse_line(R"(a,"b""",c,"d,e",f)", ',');
+
+        REQUIRE(total == 2);
+        REQUIRE(parser[0] == "d,e");
+        REQUIRE(parser[1] == R"(b")");
+        REQUIRE(std::string(parser.c_str(1)) == R"(b")");
+
+        total = parser.parse_line("a,b", ',');
+
+        REQUIRE(total == 2);
+        REQUIRE(parser.view(0).empty());
+        REQUIRE(parser.view(1) == "b");
+        REQUIRE(std::string(parser.c_str(0)).empty());
+
+        parser.select({});
+        REQUIRE(parser.parse_line("a,b,c", ',') == 3);
+    }
+
+    SECTION("csv parser rejects duplicated selections") {
+        REQUIRE_THROWS_AS(parser.select({1, 1}), std::invalid_argument);
+    }
+
+    SECTION("csv parser matches the reference parser on random lines") {
+        static const char alphabet[] = "ab,,\"\" ";
+        std::mt19937 random(7);
+        std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+
+        for (size_t size = 0; size < 200; size++) {
+            std::string line(size, ' ');
+            for (char& c : line) {
+                c = alphabet[pick(random)];
+            }
+
+            const auto expected = reference_parse(line, ',');
+            REQUIRE(parser.parse_line(line, ',') == expected.size());
+            for (size_t i = 0; i < expected.size(); i++) {
+                REQUIRE(parser[i] == expected[i]);
+            }
+        }
+    }
 }
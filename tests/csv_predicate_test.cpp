@@ -0,0 +1,91 @@
+//
+// Created by Andres Jaimes on 23/08/25.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_reader.h"
+
+TEST_CASE("csv predicates", "[csv][filter]") {
+
+    sevilla::csv_parser parser;
+
+    SECTION("csv predicates test unescaped fields") {
+        REQUIRE(sevilla::csv_predicate::equals(0, "ab").test("ab"));
+        REQUIRE_FALSE(sevilla::csv_predicate::equals(0, "ab").test("abc"));
+        REQUIRE(sevilla::csv_predicate::prefix(0, "ERR").test("ERROR"));
+        REQUIRE_FALSE(sevilla::csv_predicate::prefix(0, "ERR").test("ER"));
+        REQUIRE(sevilla::csv_predicate::range(0, 1, 2).test("1.5"));
+        REQUIRE(sevilla::csv_predicate::range(0, 1, 2).test("2"));
+        REQUIRE_FALSE(sevilla::csv_predicate::range(0, 1, 2).test("2.5"));
+        REQUIRE_FALSE(sevilla::csv_predicate::range(0, 1, 2).test("x"));
+    }
+
+    SECTION("csv parser drops rows that fail a filter") {
+        parser.add_filter(sevilla::csv_predicate::equals(1, R"(a"b)"));
+        parser.add_filter(sevilla::csv_predicate::range(2, 0, 10));
+
+        REQUIRE(parser.parse_line(R"(x,"a""b",5,y)", ',') == 4);
+        REQUIRE(parser.accepted());
+        REQUIRE(parser[3] == "y");
+
+        REQUIRE(parser.parse_line(R"(x,"a""b",50,y)", ',') == 0);
+        REQUIRE_FALSE(parser.accepted());
+        REQUIRE(parser.parse_line(R"(x,ab,5,y)", ',') == 0);
+        REQUIRE(parser.parse_line(R"(x,"a""b")", ',') == 0);
+
+        parser.clear_filters();
+        REQUIRE(parser.parse_line(R"(x,ab,5,y)", ',') == 4);
+        REQUIRE(parser.accepted());
+    }
+
+    SECTION("csv parser filters on columns outside the projection") {
+        parser.select({0});
+        parser.add_filter(sevilla::csv_predicate::prefix(2, "ok"));
+
+        REQUIRE(parser.parse_line("a,b,okay", ',') == 1);
+        REQUIRE(parser.view(0) == "a");
+        REQUIRE(parser.parse_line("a,b,no", ',') == 0);
+    }
+
+    SECTION("csv parser filters missing columns as empty fields") {
+        parser.add_filter(sevilla::csv_predicate::equals(3, ""));
+
+        REQUIRE(parser.parse_line("a,b", ',') == 2);
+        REQUIRE(parser.parse_line("a,b,c,d", ',') == 0);
+    }
+
+    SECTION("csv reader skips filtered records") {
+        const std::string data = "level,message\nINFO,a\nERROR,\"b\nc\"\nINFO,d\nERROR,e";
+        sevilla::csv_reader reader;
+        reader.open(data.data(), data.size(), ',');
+        reader.add_filter(sevilla::csv_predicate::equals(0, "ERROR"));
+        reader.read_header();
+
+        REQUIRE(reader.next());
+        REQUIRE(reader.view("message") == "b\nc");
+        REQUIRE(reader.row() == 3);
+        REQUIRE(reader.next());
+        REQUIRE(reader.view("message") == "e");
+        REQUIRE_FALSE(reader.next());
+        REQUIRE(reader.size() == 0);
+    }
+
+    SECTION("csv reader filters in parallel") {
+        std::string data;
+        for (size_t r = 0; r < 100000; r++) {
+            data += std::to_string(r) + (r % 10 == 0 ? ",keep\n" : ",drop\n");
+        }
+        sevilla::csv_reader reader;
+        reader.open(data.data(), data.size(), ',');
+        reader.add_filter(sevilla::csv_predicate::equals(1, "keep"));
+
+        size_t rows = 0;
+        for (const sevilla::csv_table& table : reader.read_parallel(4)) {
+            for (size_t r = 0; r < table.rows(); r++) {
+                REQUIRE(table.field(r, 0) == std::to_string(rows * 10));
+                rows++;
+            }
+        }
+        REQUIRE(rows == 10000);
+    }
+}
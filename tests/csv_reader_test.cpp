@@ -0,0 +1,204 @@
+//
+// Created by Andres Jaimes on 12/07/25.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_reader.h"
+
+namespace {
+
+    /**
+     * Builds rows whose quoted fields often hold separators, escaped quotes and line breaks.
+     */
+    std::string make_data(const size_t rows) {
+        std::mt19937 random(99);
+        std::uniform_int_distribution<int> kind(0, 3);
+        std::string data;
+
+        for (size_t r = 0; r < rows; r++) {
+            data += std::to_string(r) + ",";
+            switch (kind(random)) {
+                case 0: data += "\"multi\nline, \"\"quoted\"\"\r\nfield\""; break;
+                case 1: data += "\"plain quoted\""; break;
+                default: data += "plain"; break;
+            }
+            data += r % 2 == 0 ? "\n" : "\r\n";
+        }
+
+        return data;
+    }
+
+    std::string write_file(const std::string& name, const std::string& content) {
+        const std::string path = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+        return path;
+    }
+
+}
+
+TEST_CASE("csv reader", "[csv][reader]") {
+
+    sevilla::csv_reader reader;
+
+    SECTION("csv reader iterates over the records of a file") {
+        const std::string path = write_file("sevilla_reader_simple.csv", "a,b,c\n1,2,3\n");
+        reader.open(path, ',');
+
+        REQUIRE(reader.next());
+        REQUIRE(reader.size() == 3);
+        REQUIRE(reader[0] == "a");
+        REQUIRE(reader.next());
+        REQUIRE(reader.view(2) == "3");
+        REQUIRE(reader.offset() == 6);
+        REQUIRE_FALSE(reader.next());
+        REQUIRE(reader.row() == 2);
+
+        reader.close();
+        std::filesystem::remove(path);
+    }
+
+    SECTION("csv reader keeps line breaks inside quoted fields") {
+        const char data[] = "id,note\r\n1,\"first\r\nline\"\r\n2,\"say \"\"hi\"\"\nok\"";
+        reader.open(data, sizeof(data) - 1, ',');
+
+        REQUIRE(reader.next());
+        REQUIRE(reader.view(1) == "note");
+        REQUIRE(reader.next());
+        REQUIRE(reader.size() == 2);
+        REQUIRE(reader.view(1) == "first\r\nline");
+        REQUIRE(reader.next());
+        REQUIRE(reader.view(1) == "say \"hi\"\nok");
+        REQUIRE_FALSE(reader.next());
+    }
+
+    SECTION("csv reader keeps empty lines as single empty fields") {
+        const char data[] = "a\n\nb";
+        reader.open(data, sizeof(data) - 1, ',');
+
+        REQUIRE(reader.next());
+        REQUIRE(reader.next());
+        REQUIRE(reader.size() == 1);
+        REQUIRE(reader.view(0).empty());
+        REQUIRE(reader.next());
+        REQUIRE(reader.view(0) == "b");
+        REQUIRE_FALSE(reader.next());
+    }
+
+    SECTION("csv reader handles empty files") {
+        const std::string path = write_file("sevilla_reader_empty.csv", "");
+        reader.open(path, ',');
+
+        REQUIRE_FALSE(reader.next());
+
+        reader.close();
+        std::filesystem::remove(path);
+    }
+
+    SECTION("csv reader throws on missing files") {
+        REQUIRE_THROWS_AS(reader.open("/nonexistent/sevilla.csv", ','), std::runtime_error);
+    }
+
+    SECTION("csv reader refuses carriage return line breaks") {
+        const std::string data = "a,b\r1,2\r";
+        sevilla::csv_dialect dialect;
+        dialect.line_break = "\r";
+
+        REQUIRE_THROWS_AS(reader.open(data.data(), data.size(), dialect), std::invalid_argument);
+
+        dialect.line_break = "\r\n";
+        const std::string crlf = "a,b\r\n1,2\r\n";
+        reader.open(crlf.data(), crlf.size(), dialect);
+        REQUIRE(reader.next());
+        REQUIRE(reader.view(1) == "b");
+    }
+
+    SECTION("csv reader selects columns by header name") {
+        const char data[] = "id,name,\"note\nmore\",score\n1,ann,x,10\n2,bob,\"y\ny\",20\n";
+        reader.open(data, sizeof(data) - 1, ',');
+        reader.select(std::vector<std::string>{"score", "id"});
+
+        REQUIRE(reader.next());
+        REQUIRE(reader.size() == 2);
+        REQUIRE(reader.view(0) == "10");
+        REQUIRE(reader.view(1) == "1");
+        REQUIRE(reader.next());
+        REQUIRE(reader.view(0) == "20");
+        REQUIRE_FALSE(reader.next());
+
+        reader.open(data, sizeof(data) - 1, ',');
+        REQUIRE_THROWS_AS(reader.select(std::vector<std::string>{"missing"}), std::invalid_argument);
+    }
+
+    SECTION("csv reader looks fields up by header name") {
+        const std::string data = "id,name,total\n1,\"a,b\",3\n";
+        reader.open(data.data(), data.size(), ',');
+        reader.read_header();
+
+        REQUIRE(reader.next());
+        REQUIRE(reader["name"] == "a,b");
+        REQUIRE(reader.view("total") == "3");
+
+        reader.open(data.data(), data.size(), ',');
+        reader.select(std::vector<std::string>{"total", "id"});
+        REQUIRE(reader.next());
+        REQUIRE(reader.view("total") == "3");
+        REQUIRE(reader.view("id") == "1");
+        REQUIRE_THROWS_AS(reader.view("name"), std::out_of_range);
+    }
+
+    SECTION("csv reader parses in parallel in file order") {
+        const std::string data = make_data(40000);
+        std::vector<std::vector<std::string>> expected;
+
+        reader.open(data.data(), data.size(), ',');
+        while (reader.next()) {
+            expected.push_back({reader[0], reader[1]});
+        }
+
+        for (const size_t threads : {1, 3, 8}) {
+            reader.open(data.data(), data.size(), ',');
+            const auto tables = reader.read_parallel(threads);
+
+            size_t row = 0;
+            for (const sevilla::csv_table& table : tables) {
+                for (size_t r = 0; r < table.rows(); r++, row++) {
+                    REQUIRE(row < expected.size());
+                    REQUIRE(table.row_size(r) == 2);
+                    REQUIRE(table.field(r, 0) == expected[row][0]);
+                    REQUIRE(table.field(r, 1) == expected[row][1]);
+                }
+            }
+            REQUIRE(row == expected.size());
+            REQUIRE(reader.row() == expected.size());
+            REQUIRE_FALSE(reader.next());
+        }
+    }
+
+    SECTION("csv reader counts the filtered out records when parsing in parallel") {
+        const std::string data = make_data(40000);
+        size_t kept = 0;
+
+        reader.open(data.data(), data.size(), ',');
+        reader.add_filter(sevilla::csv_predicate::equals(1, "plain"));
+        while (reader.next()) {
+            kept++;
+        }
+        REQUIRE(reader.row() == 40000);
+
+        for (const size_t threads : {1, 3, 8}) {
+            reader.open(data.data(), data.size(), ',');
+            const auto tables = reader.read_parallel(threads);
+
+            size_t rows = 0;
+            for (const sevilla::csv_table& table : tables) {
+                rows += table.rows();
+            }
+            REQUIRE(rows == kept);
+            REQUIRE(reader.row() == 40000);
+        }
+    }
+}
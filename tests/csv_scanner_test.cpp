@@ -0,0 +1,119 @@
+//
+// Created by Andres Jaimes on 05/07/25.
+//
+
+#include <random>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_scanner.h"
+
+namespace {
+
+    std::vector<size_t> scan(sevilla::csv_scanner& scanner, const std::string& data, const bool line_breaks,
+                             bool& in_quotes) {
+        const size_t count = scanner.scan(data.data(), data.size(), ',', '"', line_breaks, in_quotes);
+        return {scanner.offsets(), scanner.offsets() + count};
+    }
+
+    std::string random_csv(std::mt19937& random, const size_t size) {
+        static const char alphabet[] = "abc,,\"\"\n\r ";
+        std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+        std::string data(size, ' ');
+        for (char& c : data) {
+            c = alphabet[pick(random)];
+        }
+        return data;
+    }
+
+}
+
+TEST_CASE("csv scanner", "[csv][scanner]") {
+
+    sevilla::csv_scanner scalar(sevilla::csv_scanner::engine::scalar);
+
+    SECTION("csv scanner finds separators and quotes") {
+        bool in_quotes = false;
+        const auto offsets = scan(scalar, R"(a,"b,c",d)", false, in_quotes);
+
+        REQUIRE(offsets == std::vector<size_t>{1, 2, 6, 7});
+        REQUIRE_FALSE(in_quotes);
+    }
+
+    SECTION("csv scanner stops at the first unquoted line break") {
+        bool in_quotes = false;
+        const auto offsets = scan(scalar, "a,\"b\nc\"\nd,e", true, in_quotes);
+
+        REQUIRE(offsets == std::vector<size_t>{1, 2, 6, 7});
+        REQUIRE_FALSE(in_quotes);
+    }
+
+    SECTION("csv scanner carries the quoted state") {
+        bool in_quotes = true;
+        const auto offsets = scan(scalar, "a,b\",c", false, in_quotes);
+
+        REQUIRE(offsets == std::vector<size_t>{3, 4});
+        REQUIRE_FALSE(in_quotes);
+    }
+
+    SECTION("csv scanner engines agree with the scalar engine") {
+        std::mt19937 random(42);
+
+        for (const auto engine : {sevilla::csv_scanner::engine::sse2, sevilla::csv_scanner::engine::avx2}) {
+            if (!sevilla::csv_scanner::supported(engine)) {
+                continue;
+            }
+            sevilla::csv_scanner vector(engine);
+
+            for (size_t size = 0; size < 300; size++) {
+                const std::string data = random_csv(random, size);
+                for (const bool line_breaks : {false, true}) {
+                    for (const bool quoted : {false, true}) {
+                        bool scalar_quotes = quoted;
+                        bool vector_quotes = quoted;
+                        const auto expected = scan(scalar, data, line_breaks, scalar_quotes);
+                        const auto actual = scan(vector, data, line_breaks, vector_quotes);
+
+                        REQUIRE(actual == expected);
+                        REQUIRE(vector_quotes == scalar_quotes);
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("csv scanner finds the first character that needs quoting") {
+        REQUIRE(scalar.find_special("abc", 3, ',', '"') == 3);
+        REQUIRE(scalar.find_special("ab,c", 4, ',', '"') == 2);
+        REQUIRE(scalar.find_special("a\rb", 3, ',', '"') == 1);
+        REQUIRE(scalar.find_special("a;b", 3, ';', '\'') == 1);
+        REQUIRE(scalar.find_special("", 0, ',', '"') == 0);
+    }
+
+    SECTION("csv scanner engines find the same special characters") {
+        std::mt19937 random(7);
+        std::uniform_int_distribution<size_t> position(0, 299);
+
+        for (const auto engine : {sevilla::csv_scanner::engine::sse2, sevilla::csv_scanner::engine::avx2}) {
+            if (!sevilla::csv_scanner::supported(engine)) {
+                continue;
+            }
+            const sevilla::csv_scanner vector(engine);
+
+            for (size_t size = 0; size < 300; size++) {
+                std::string data(size, 'x');
+                if (size > 0) {
+                    data[position(random) % size] = "\"\n\r,"[size % 4];
+                }
+                REQUIRE(vector.find_special(data.data(), size, ',', '"') ==
+                        scalar.find_special(data.data(), size, ',', '"'));
+            }
+        }
+    }
+
+    SECTION("csv scanner rejects unsupported engines") {
+        for (const auto engine : {sevilla::csv_scanner::engine::sse2, sevilla::csv_scanner::engine::avx2}) {
+            if (!sevilla::csv_scanner::supported(engine)) {
+                REQUIRE_THROWS_AS(sevilla::csv_scanner(engine), std::invalid_argument);
+            }
+        }
+    }
+}
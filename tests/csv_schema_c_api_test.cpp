@@ -0,0 +1,68 @@
+//
+// Created by Andres Jaimes on 27/09/25.
+//
+
+#include <dlfcn.h>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/json.hpp"
+
+#if defined(_WIN32)
+    #define LIBNAME "sevilla.dll"
+#elif defined(__APPLE__)
+    #define LIBNAME "libsevilla.dylib"
+#else
+    #define LIBNAME "libsevilla.so"
+#endif
+
+struct CsvSchemaLoaderFixture {
+
+    typedef const char* (*infer_func)(const char*, size_t, char, int);
+    infer_func csv_infer_schema;
+    typedef const char* (*infer_file_func)(const char*, char, int);
+    infer_file_func csv_infer_schema_file;
+    void* handle = nullptr;
+
+    // load the dynamic library
+    CsvSchemaLoaderFixture() {
+        handle = dlopen(LIBNAME, RTLD_NOW);
+        if (handle != nullptr) {
+            csv_infer_schema = reinterpret_cast<infer_func>(dlsym(handle, "sv_csv_infer_schema"));
+            csv_infer_schema_file = reinterpret_cast<infer_file_func>(dlsym(handle, "sv_csv_infer_schema_file"));
+        }
+    }
+
+    // unload the dynamic library
+    ~CsvSchemaLoaderFixture() {
+        if (handle != nullptr) {
+            dlclose(handle);
+        }
+    }
+};
+
+TEST_CASE_METHOD(CsvSchemaLoaderFixture, "csv schema c-api", "[csv][shared]") {
+
+    REQUIRE(handle != nullptr);
+
+    SECTION("returns the schema as json") {
+        const std::string data = "id;score;name\n1;2.5;a\n2;;b\n";
+        const nlohmann::json j = nlohmann::json::parse(csv_infer_schema(data.data(), data.size(), ';', 1));
+
+        REQUIRE(j["rows"] == 2);
+        REQUIRE(j["columns"].size() == 3);
+        REQUIRE(j["columns"][0]["name"] == "id");
+        REQUIRE(j["columns"][0]["type"] == "int64");
+        REQUIRE(j["columns"][0]["type_id"] == 1);
+        REQUIRE(j["columns"][0]["nullable"] == false);
+        REQUIRE(j["columns"][1]["type"] == "float64");
+        REQUIRE(j["columns"][1]["nullable"] == true);
+        REQUIRE(j["columns"][2]["type"] == "utf8");
+    }
+
+    SECTION("reports missing files") {
+        const nlohmann::json j = nlohmann::json::parse(csv_infer_schema_file("/nonexistent/sevilla.csv", ',', 0));
+        REQUIRE(j.contains("error"));
+        REQUIRE(nlohmann::json::parse(csv_infer_schema_file(nullptr, ',', 0)).contains("error"));
+    }
+
+}
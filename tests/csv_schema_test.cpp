@@ -0,0 +1,112 @@
+//
+// Created by Andres Jaimes on 27/09/25.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_column_batch.h"
+#include "../src/csv_schema.h"
+
+namespace {
+
+    sevilla::csv_dialect with_header() {
+        sevilla::csv_dialect dialect;
+        dialect.header = true;
+        return dialect;
+    }
+
+}
+
+TEST_CASE("csv schema", "[csv][schema]") {
+
+    SECTION("csv schema picks the narrowest type of every column") {
+        const std::string data =
+            "id,price,active,created,name,mixed\n"
+            "1,9.5,true,2025-09-27,apple,1\n"
+            "2,10,no,2025-09-27T10:30:00Z,pear,yes\n"
+            "-3,1e3,Y,2025-09-28 08:00:00,fig,x\n";
+        const sevilla::csv_schema schema = sevilla::csv_schema_inferrer().infer(data.data(), data.size(), with_header());
+
+        REQUIRE(schema.rows == 3);
+        REQUIRE(schema.columns.size() == 6);
+        REQUIRE(schema.columns[0].name == "id");
+        REQUIRE(schema.columns[5].name == "mixed");
+        REQUIRE(schema.types() == std::vector<sevilla::csv_type>{
+            sevilla::csv_type::int64, sevilla::csv_type::float64, sevilla::csv_type::boolean,
+            sevilla::csv_type::timestamp, sevilla::csv_type::utf8, sevilla::csv_type::utf8});
+        for (const sevilla::csv_column_schema& column : schema.columns) {
+            REQUIRE_FALSE(column.nullable);
+        }
+    }
+
+    SECTION("csv schema marks empty and missing fields as nullable") {
+        const std::string data = "1,,x\n2,3\n,4,y\n";
+        const sevilla::csv_schema schema = sevilla::csv_schema_inferrer().infer(data.data(), data.size());
+
+        REQUIRE(schema.columns.size() == 3);
+        REQUIRE(schema.columns[0].name.empty());
+        REQUIRE(schema.columns[0].type == sevilla::csv_type::int64);
+        REQUIRE(schema.columns[0].nullable);
+        REQUIRE(schema.columns[1].type == sevilla::csv_type::int64);
+        REQUIRE(schema.columns[1].nullable);
+        REQUIRE(schema.columns[2].type == sevilla::csv_type::utf8);
+        REQUIRE(schema.columns[2].nullable);
+    }
+
+    SECTION("csv schema keeps header columns without values") {
+        const std::string data = "a,b\n";
+        const sevilla::csv_schema schema = sevilla::csv_schema_inferrer().infer(data.data(), data.size(), with_header());
+
+        REQUIRE(schema.rows == 0);
+        REQUIRE(schema.columns.size() == 2);
+        REQUIRE(schema.columns[1].name == "b");
+        REQUIRE(schema.columns[1].type == sevilla::csv_type::utf8);
+    }
+
+    SECTION("csv schema samples records past the head") {
+        // the second column only stops being an integer far into the data
+        std::string data = "id,value,note\n";
+        for (size_t r = 0; r < 50000; r++) {
+            data += std::to_string(r) + "," + (r < 40000 ? std::to_string(r) : "1.5") + ",\"a\nb\"\n";
+        }
+
+        const sevilla::csv_schema head = sevilla::csv_schema_inferrer(100, 0).infer(data.data(), data.size(), with_header());
+        REQUIRE(head.rows == 100);
+        REQUIRE(head.columns[1].type == sevilla::csv_type::int64);
+
+        const sevilla::csv_schema sampled = sevilla::csv_schema_inferrer(100, 500, 7).infer(data.data(), data.size(), with_header());
+        REQUIRE(sampled.rows > 100);
+        REQUIRE(sampled.rows <= 600);
+        REQUIRE(sampled.columns[0].type == sevilla::csv_type::int64);
+        REQUIRE(sampled.columns[1].type == sevilla::csv_type::float64);
+        // records read from inside a quoted field have other widths, and are left out
+        REQUIRE(sampled.columns[2].type == sevilla::csv_type::utf8);
+        REQUIRE_FALSE(sampled.columns[2].nullable);
+    }
+
+    SECTION("csv schema types column batches") {
+        const std::string path = (std::filesystem::temp_directory_path() / "sevilla_schema_test.csv").string();
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "n,ok\n1,t\n2,f\n3,\n";
+        }
+
+        const sevilla::csv_schema schema = sevilla::csv_schema_inferrer().infer_file(path, with_header());
+        REQUIRE(schema.columns[1].type == sevilla::csv_type::boolean);
+        REQUIRE(schema.columns[1].nullable);
+
+        sevilla::csv_reader reader;
+        reader.open(path, with_header());
+        sevilla::csv_column_batch batch;
+        batch.set_types(schema.types());
+        REQUIRE(batch.read(reader, 10) == 3);
+        REQUIRE(batch.column(0).type == sevilla::csv_type::int64);
+        REQUIRE(batch.column(1).null_count == 1);
+
+        reader.close();
+        std::filesystem::remove(path);
+        REQUIRE_THROWS(sevilla::csv_schema_inferrer().infer_file(path));
+    }
+
+}
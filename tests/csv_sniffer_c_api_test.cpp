@@ -0,0 +1,64 @@
+//
+// Created by Andres Jaimes on 30/08/25.
+//
+
+#include <dlfcn.h>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/json.hpp"
+
+#if defined(_WIN32)
+    #define LIBNAME "sevilla.dll"
+#elif defined(__APPLE__)
+    #define LIBNAME "libsevilla.dylib"
+#else
+    #define LIBNAME "libsevilla.so"
+#endif
+
+struct CsvSnifferLoaderFixture {
+
+    typedef const char* (*sniff_func)(const char*, size_t);
+    sniff_func csv_sniff;
+    typedef const char* (*sniff_file_func)(const char*);
+    sniff_file_func csv_sniff_file;
+    void* handle = nullptr;
+
+    // load the dynamic library
+    CsvSnifferLoaderFixture() {
+        handle = dlopen(LIBNAME, RTLD_NOW);
+        if (handle != nullptr) {
+            csv_sniff = reinterpret_cast<sniff_func>(dlsym(handle, "sv_csv_sniff"));
+            csv_sniff_file = reinterpret_cast<sniff_file_func>(dlsym(handle, "sv_csv_sniff_file"));
+        }
+    }
+
+    // unload the dynamic library
+    ~CsvSnifferLoaderFixture() {
+        if (handle != nullptr) {
+            dlclose(handle);
+        }
+    }
+};
+
+TEST_CASE_METHOD(CsvSnifferLoaderFixture, "csv sniffer c-api", "[csv][shared]") {
+
+    REQUIRE(handle != nullptr);
+
+    SECTION("returns the dialect as json") {
+        const std::string data = "a\tb\n1\t2\n3\t4\n";
+        const nlohmann::json j = nlohmann::json::parse(csv_sniff(data.data(), data.size()));
+
+        REQUIRE(j["separator"] == "\t");
+        REQUIRE(j["quote"] == "\"");
+        REQUIRE(j["line_break"] == "\n");
+        REQUIRE(j["header"] == true);
+        REQUIRE(j["columns"] == 2);
+    }
+
+    SECTION("reports missing files") {
+        const nlohmann::json j = nlohmann::json::parse(csv_sniff_file("/nonexistent/sevilla.csv"));
+        REQUIRE(j.contains("error"));
+        REQUIRE(nlohmann::json::parse(csv_sniff_file(nullptr)).contains("error"));
+    }
+
+}
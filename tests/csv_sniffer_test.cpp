@@ -0,0 +1,79 @@
+//
+// Created by Andres Jaimes on 30/08/25.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_reader.h"
+
+TEST_CASE("csv sniffer", "[csv][sniffer]") {
+
+    const sevilla::csv_sniffer sniffer;
+
+    SECTION("csv sniffer detects separators") {
+        const std::string data = "id;name;when\n1;\"a;b\";10:30:00\n2;c;11:45:00\n3;d;12:00:00\n";
+        const sevilla::csv_dialect dialect = sniffer.sniff(data.data(), data.size());
+
+        REQUIRE(dialect.separator == ';');
+        REQUIRE(dialect.quote == '"');
+        REQUIRE(dialect.line_break == "\n");
+        REQUIRE(dialect.columns == 3);
+        REQUIRE(dialect.header);
+    }
+
+    SECTION("csv sniffer detects tabs, single quotes and crlf") {
+        const std::string data = "'it''s'\t1.5\r\n'x\ty'\t2\r\n'z'\t3\r\n";
+        const sevilla::csv_dialect dialect = sniffer.sniff(data.data(), data.size());
+
+        REQUIRE(dialect.separator == '\t');
+        REQUIRE(dialect.quote == '\'');
+        REQUIRE(dialect.line_break == "\r\n");
+        REQUIRE(dialect.columns == 2);
+        REQUIRE_FALSE(dialect.header);
+    }
+
+    SECTION("csv sniffer handles carriage return line breaks") {
+        const std::string data = "a|b\r1|2\r3|4\r";
+        const sevilla::csv_dialect dialect = sniffer.sniff(data.data(), data.size());
+
+        REQUIRE(dialect.separator == '|');
+        REQUIRE(dialect.line_break == "\r");
+        REQUIRE(dialect.header);
+    }
+
+    SECTION("csv sniffer falls back to a single column") {
+        const std::string data = "alpha\nbeta\n";
+        const sevilla::csv_dialect dialect = sniffer.sniff(data.data(), data.size());
+
+        REQUIRE(dialect.separator == ',');
+        REQUIRE(dialect.columns == 1);
+        REQUIRE(sniffer.sniff(nullptr, 0).columns == 0);
+    }
+
+    SECTION("csv sniffer ignores a record cut by the sample") {
+        const sevilla::csv_sniffer small(24);
+        const std::string data = "a,b,c\n1,2,3\n4,5,6\n7,8;9;10;11;12\n";
+        const sevilla::csv_dialect dialect = small.sniff(data.data(), data.size());
+
+        REQUIRE(dialect.separator == ',');
+        REQUIRE(dialect.columns == 3);
+    }
+
+    SECTION("csv reader opens files in a sniffed dialect") {
+        const std::string path = (std::filesystem::temp_directory_path() / "sevilla_sniffed.csv").string();
+        std::ofstream(path, std::ios::binary) << "name|total\n'x|y'|1\n'z'|2\n";
+
+        const sevilla::csv_dialect dialect = sniffer.sniff_file(path);
+        sevilla::csv_reader reader;
+        reader.open(path, dialect);
+
+        REQUIRE(reader.next());
+        REQUIRE(reader.view("name") == "x|y");
+        REQUIRE(reader.view("total") == "1");
+        reader.close();
+        std::filesystem::remove(path);
+
+        REQUIRE_THROWS_AS(sniffer.sniff_file(path), std::runtime_error);
+    }
+}
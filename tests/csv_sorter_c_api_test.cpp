@@ -0,0 +1,89 @@
+//
+// Created by Andres Jaimes on 14/10/25.
+//
+
+#include <dlfcn.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/json.hpp"
+
+#if defined(_WIN32)
+    #define LIBNAME "sevilla.dll"
+#elif defined(__APPLE__)
+    #define LIBNAME "libsevilla.dylib"
+#else
+    #define LIBNAME "libsevilla.so"
+#endif
+
+struct CsvSorterLoaderFixture {
+
+    typedef const char* (*sort_func)(const char*, const char*, const size_t*, const int*, size_t, char, int, size_t);
+    sort_func csv_sort;
+    sort_func csv_group_count;
+    void* handle = nullptr;
+
+    // load the dynamic library
+    CsvSorterLoaderFixture() {
+        handle = dlopen(LIBNAME, RTLD_NOW);
+        if (handle != nullptr) {
+            csv_sort = reinterpret_cast<sort_func>(dlsym(handle, "sv_csv_sort"));
+            csv_group_count = reinterpret_cast<sort_func>(dlsym(handle, "sv_csv_group_count"));
+        }
+    }
+
+    // unload the dynamic library
+    ~CsvSorterLoaderFixture() {
+        if (handle != nullptr) {
+            dlclose(handle);
+        }
+    }
+};
+
+TEST_CASE_METHOD(CsvSorterLoaderFixture, "csv sorter c-api", "[csv][shared]") {
+
+    REQUIRE(handle != nullptr);
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string input = (directory / "sevilla_sorter_c_api_input.csv").string();
+    const std::string output = (directory / "sevilla_sorter_c_api_output.csv").string();
+    {
+        std::ofstream file(input, std::ios::binary | std::ios::trunc);
+        file << "city;n\nrome;10\nparis;9\nrome;2\n";
+    }
+
+    const auto read = [&] {
+        std::ifstream file(output, std::ios::binary);
+        std::stringstream text;
+        text << file.rdbuf();
+        return text.str();
+    };
+
+    SECTION("sorts by keys with flags") {
+        const size_t columns[] = {1};
+        const int flags[] = {1 | 2};
+        const nlohmann::json j = nlohmann::json::parse(csv_sort(input.c_str(), output.c_str(), columns, flags, 1, ';', 1, 0));
+
+        REQUIRE(j["rows"] == 3);
+        REQUIRE(read() == "city;n\nrome;10\nparis;9\nrome;2\n");
+    }
+
+    SECTION("counts records by key") {
+        const size_t columns[] = {0};
+        const nlohmann::json j = nlohmann::json::parse(csv_group_count(input.c_str(), output.c_str(), columns, nullptr, 1, ';', 1, 1));
+
+        REQUIRE(j["groups"] == 2);
+        REQUIRE(read() == "city;count\nparis;1\nrome;2\n");
+    }
+
+    SECTION("returns errors as json") {
+        const size_t columns[] = {0};
+        REQUIRE(nlohmann::json::parse(csv_sort(nullptr, output.c_str(), columns, nullptr, 1, ';', 1, 0)).contains("error"));
+        REQUIRE(nlohmann::json::parse(csv_sort(input.c_str(), output.c_str(), columns, nullptr, 0, ';', 1, 0)).contains("error"));
+    }
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
@@ -0,0 +1,190 @@
+//
+// Created by Andres Jaimes on 14/10/25.
+//
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_sorter.h"
+
+namespace {
+
+    void write(const std::string& path, const std::string& text) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << text;
+    }
+
+    std::string read(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream text;
+        text << file.rdbuf();
+        return text.str();
+    }
+
+}
+
+TEST_CASE("csv sorter", "[csv][sorter]") {
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string input = (directory / "sevilla_sorter_input.csv").string();
+    const std::string output = (directory / "sevilla_sorter_output.csv").string();
+
+    sevilla::csv_dialect dialect;
+    dialect.header = true;
+
+    SECTION("csv sorter sorts by text keys and keeps quoted line breaks") {
+        write(input, "name,city\nzoe,paris\n\"b,ob\",\"new\nyork\"\nann,rome\n");
+
+        const sevilla::csv_sorter sorter({sevilla::csv_sort_key{0}});
+        REQUIRE(sorter.sort(input, output, dialect) == 3);
+        REQUIRE(read(output) == "name,city\nann,rome\n\"b,ob\",\"new\nyork\"\nzoe,paris\n");
+    }
+
+    SECTION("csv sorter compares numeric keys as numbers, before other fields") {
+        write(input, "n\n10\nx\n9\n-1.5\nabc\n");
+
+        const sevilla::csv_sorter sorter({{0, true}});
+        REQUIRE(sorter.sort(input, output, dialect) == 5);
+        REQUIRE(read(output) == "n\n-1.5\n9\n10\nabc\nx\n");
+    }
+
+    SECTION("csv sorter sorts nan after numbers and infinities among them") {
+        write(input, "n\n5\nnan\n1\ninf\n3\nnan\n2\n-inf\n4\n0\n");
+
+        const sevilla::csv_sorter sorter({{0, true}});
+        REQUIRE(sorter.sort(input, output, dialect) == 10);
+        REQUIRE(read(output) == "n\n-inf\n0\n1\n2\n3\n4\n5\ninf\nnan\nnan\n");
+    }
+
+    SECTION("csv sorter keeps other fields last with descending numeric keys") {
+        write(input, "n\n2\nabc\n10\nnan\n1\n");
+
+        sevilla::csv_sorter sorter({{0, true, true}});
+        REQUIRE(sorter.sort(input, output, dialect) == 5);
+        REQUIRE(read(output) == "n\n10\n2\n1\nabc\nnan\n");
+
+        // enough records for several runs, so the order also holds when runs are merged
+        std::string text = "n\n";
+        std::vector<int> numbers;
+        std::vector<std::string> others;
+        for (int i = 0; i < 40000; i++) {
+            if (i % 7 == 0) {
+                others.push_back(i % 2 == 0 ? "nan" : "x" + std::to_string(i % 3));
+                text += others.back() + "\n";
+            } else {
+                numbers.push_back(i % 1000);
+                text += std::to_string(numbers.back()) + "\n";
+            }
+        }
+        write(input, text);
+        std::sort(numbers.rbegin(), numbers.rend());
+        std::sort(others.begin(), others.end());
+
+        std::string expected = "n\n";
+        for (const int number : numbers) {
+            expected += std::to_string(number) + "\n";
+        }
+        for (const std::string& other : others) {
+            expected += other + "\n";
+        }
+
+        sorter.set_memory_budget(64 * 1024);
+        REQUIRE(sorter.sort(input, output, dialect) == 40000);
+        REQUIRE(read(output) == expected);
+    }
+
+    SECTION("csv sorter sorts by several keys, in either order, and is stable") {
+        write(input, "g,n,id\na,1,1\nb,2,2\na,3,3\nb,2,4\na,1,5\n");
+
+        const sevilla::csv_sorter sorter({{0, false, true}, {1, true}});
+        REQUIRE(sorter.sort(input, output, dialect) == 5);
+        REQUIRE(read(output) == "g,n,id\nb,2,2\nb,2,4\na,1,1\na,1,5\na,3,3\n");
+    }
+
+    SECTION("csv sorter treats missing key columns as empty") {
+        write(input, "b,1\na\nc,0\n");
+
+        const sevilla::csv_sorter sorter({sevilla::csv_sort_key{1}});
+        REQUIRE(sorter.sort(input, output, {}) == 3);
+        REQUIRE(read(output) == "a\nc,0\nb,1\n");
+    }
+
+    SECTION("csv sorter merges runs when data exceeds the memory budget") {
+        std::mt19937 random(7);
+        std::string text = "id,value\n";
+        std::vector<std::pair<int, int>> rows;
+        for (int i = 0; i < 300000; i++) {
+            const int value = static_cast<int>(random() % 1000);
+            rows.emplace_back(value, i);
+            text += std::to_string(i) + "," + std::to_string(value) + "\n";
+        }
+        write(input, text);
+        std::stable_sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::string expected = "id,value\n";
+        for (const auto& [value, id] : rows) {
+            expected += std::to_string(id) + "," + std::to_string(value) + "\n";
+        }
+
+        sevilla::csv_sorter sorter({{1, true}});
+        sorter.set_memory_budget(64 * 1024);
+        sorter.set_threads(3);
+        REQUIRE(sorter.sort(input, output, dialect) == rows.size());
+        REQUIRE(read(output) == expected);
+
+        std::map<int, size_t> counts;
+        for (const auto& row : rows) {
+            counts[row.first]++;
+        }
+        std::string grouped = "value,count\n";
+        for (const auto& [value, count] : counts) {
+            grouped += std::to_string(value) + "," + std::to_string(count) + "\n";
+        }
+        REQUIRE(sorter.group_count(input, output, dialect) == counts.size());
+        REQUIRE(read(output) == grouped);
+    }
+
+    SECTION("csv sorter counts records by key") {
+        write(input, "city,kind,n\nrome,a,1\nparis,b,2\nrome,a,3\nrome,b,4\n");
+
+        const sevilla::csv_sorter sorter({{0}, {1}});
+        REQUIRE(sorter.group_count(input, output, dialect) == 3);
+        REQUIRE(read(output) == "city,kind,count\nparis,b,1\nrome,a,2\nrome,b,1\n");
+    }
+
+    SECTION("csv sorter removes its runs") {
+        const std::filesystem::path runs = directory / "sevilla_sorter_runs";
+        std::filesystem::create_directories(runs);
+        write(input, std::string(200000, 'x').append("\n").append(std::string(200000, 'y')).append("\n"));
+
+        sevilla::csv_sorter sorter({sevilla::csv_sort_key{0}});
+        sorter.set_memory_budget(1);
+        sorter.set_temp_directory(runs.string());
+        REQUIRE(sorter.sort(input, output, {}) == 2);
+        REQUIRE(std::filesystem::is_empty(runs));
+        std::filesystem::remove_all(runs);
+    }
+
+    SECTION("csv sorter rejects missing keys and files") {
+        REQUIRE_THROWS_AS(sevilla::csv_sorter(std::vector<sevilla::csv_sort_key>()), std::invalid_argument);
+        REQUIRE_THROWS_AS(sevilla::csv_sorter({sevilla::csv_sort_key{0}}).sort((directory / "sevilla_sorter_missing.csv").string(), output),
+                          std::runtime_error);
+    }
+
+    SECTION("csv sorter refuses to write over its input") {
+        write(input, "b\na\n");
+
+        const sevilla::csv_sorter sorter({sevilla::csv_sort_key{0}});
+        REQUIRE_THROWS_AS(sorter.sort(input, input), std::invalid_argument);
+        REQUIRE_THROWS_AS(sorter.group_count(input, (directory / "." / "sevilla_sorter_input.csv").string()),
+                          std::invalid_argument);
+        REQUIRE(read(input) == "b\na\n");
+    }
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
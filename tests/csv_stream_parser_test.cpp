@@ -0,0 +1,63 @@
+//
+// Created by Andres Jaimes on 26/07/25.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_stream_parser.h"
+
+TEST_CASE("csv stream parser", "[csv][stream]") {
+
+    std::vector<std::vector<std::string>> records;
+    sevilla::csv_stream_parser stream(',', [&records](const sevilla::csv_parser& record) {
+        std::vector<std::string> fields;
+        for (size_t i = 0; i < record.size(); i++) {
+            fields.emplace_back(record.view(i));
+        }
+        records.push_back(fields);
+    });
+
+    const std::string data = "id,note\r\n1,\"multi\r\nline, \"\"quoted\"\"\"\n2,plain\n3,\"last\"";
+    const std::vector<std::vector<std::string>> expected = {
+        {"id", "note"},
+        {"1", "multi\r\nline, \"quoted\""},
+        {"2", "plain"},
+        {"3", "last"},
+    };
+
+    SECTION("csv stream parser handles the whole data in one chunk") {
+        stream.feed(data.data(), data.size());
+        stream.finish();
+
+        REQUIRE(records == expected);
+        REQUIRE(stream.rows() == 4);
+    }
+
+    SECTION("csv stream parser carries records across every chunk size") {
+        for (size_t chunk = 1; chunk <= data.size(); chunk++) {
+            records.clear();
+            stream.reset();
+
+            for (size_t i = 0; i < data.size(); i += chunk) {
+                stream.feed(data.data() + i, std::min(chunk, data.size() - i));
+            }
+            stream.finish();
+
+            REQUIRE(records == expected);
+        }
+    }
+
+    SECTION("csv stream parser only holds the incomplete record") {
+        const std::string head = "a,b\nc,\"d\n";
+        stream.feed(head.data(), head.size());
+
+        REQUIRE(records.size() == 1);
+        REQUIRE(stream.pending_size() == 5);
+
+        const std::string tail = "e\"\n";
+        stream.feed(tail.data(), tail.size());
+
+        REQUIRE(records.size() == 2);
+        REQUIRE(records[1][1] == "d\ne");
+        REQUIRE(stream.pending_size() == 0);
+    }
+}
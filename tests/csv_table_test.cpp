@@ -0,0 +1,42 @@
+//
+// Created by Andres Jaimes on 19/07/25.
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_table.h"
+
+TEST_CASE("csv table", "[csv][table]") {
+
+    sevilla::csv_table table;
+    sevilla::csv_parser parser;
+
+    SECTION("csv table keeps rows in flat storage") {
+        parser.parse_line(R"(a,"b""c",d)", ',');
+        table.append(parser);
+        parser.parse_line("e", ',');
+        table.append(parser);
+
+        REQUIRE(table.rows() == 2);
+        REQUIRE(table.row_size(0) == 3);
+        REQUIRE(table.field(0, 1) == R"(b"c)");
+        REQUIRE(table.field(1, 0) == "e");
+        REQUIRE(table.data() == R"(ab"cde)");
+        REQUIRE(table.fields() == std::vector<size_t>{0, 1, 4, 5, 6});
+        REQUIRE(table.row_fields() == std::vector<size_t>{0, 3, 4});
+    }
+
+    SECTION("csv table indexing out of range throws") {
+        table.append({"x", "y"});
+
+        REQUIRE_THROWS_AS(table.field(0, 2), std::out_of_range);
+        REQUIRE_THROWS_AS(table.row_size(1), std::out_of_range);
+    }
+
+    SECTION("csv table clear removes every row") {
+        table.append({"x"});
+        table.clear();
+
+        REQUIRE(table.rows() == 0);
+        REQUIRE(table.data().empty());
+    }
+}
@@ -0,0 +1,98 @@
+//
+// Created by Andres Jaimes on 02/08/25.
+//
+
+#include <cmath>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_types.h"
+
+TEST_CASE("csv types", "[csv][types]") {
+
+    SECTION("parses integers") {
+        int64_t value = 0;
+
+        REQUIRE(sevilla::parse_int64("42", value));
+        REQUIRE(value == 42);
+        REQUIRE(sevilla::parse_int64("-9223372036854775808", value));
+        REQUIRE(value == INT64_MIN);
+        REQUIRE(sevilla::parse_int64("+7", value));
+        REQUIRE(value == 7);
+        REQUIRE_FALSE(sevilla::parse_int64("9223372036854775808", value));
+        REQUIRE_FALSE(sevilla::parse_int64(" 1", value));
+        REQUIRE_FALSE(sevilla::parse_int64("1.5", value));
+        REQUIRE_FALSE(sevilla::parse_int64("", value));
+        REQUIRE_FALSE(sevilla::parse_int64("+", value));
+    }
+
+    SECTION("parses doubles") {
+        double value = 0;
+
+        REQUIRE(sevilla::parse_double("3.25", value));
+        REQUIRE(value == 3.25);
+        REQUIRE(sevilla::parse_double("-0.1", value));
+        REQUIRE(value == -0.1);
+        REQUIRE(sevilla::parse_double("1e-5", value));
+        REQUIRE(value == 1e-5);
+        REQUIRE(sevilla::parse_double(".5", value));
+        REQUIRE(value == 0.5);
+        REQUIRE(sevilla::parse_double("12345678901234567890123", value));
+        REQUIRE(value == 12345678901234567890123.0);
+        REQUIRE(sevilla::parse_double("2.2250738585072014e-308", value));
+        REQUIRE(value == 2.2250738585072014e-308);
+        REQUIRE(sevilla::parse_double("0.30000000000000004", value));
+        REQUIRE(value == 0.30000000000000004);
+        REQUIRE(sevilla::parse_double("inf", value));
+        REQUIRE(std::isinf(value));
+        REQUIRE(sevilla::parse_double("+1e300", value));
+        REQUIRE(value == 1e300);
+        REQUIRE(sevilla::parse_double("+12345678901234567890123", value));
+        REQUIRE(value == 12345678901234567890123.0);
+        REQUIRE_FALSE(sevilla::parse_double("+-1e300", value));
+        REQUIRE_FALSE(sevilla::parse_double("1e", value));
+        REQUIRE_FALSE(sevilla::parse_double("1,5", value));
+        REQUIRE_FALSE(sevilla::parse_double("", value));
+        REQUIRE_FALSE(sevilla::parse_double(".", value));
+        REQUIRE_FALSE(sevilla::parse_double("0x1p3", value));
+        REQUIRE_FALSE(sevilla::parse_double(" 1.5", value));
+        REQUIRE_FALSE(sevilla::parse_double("1e400", value));
+        REQUIRE(sevilla::parse_double("-Infinity", value));
+        REQUIRE(std::isinf(value));
+        REQUIRE(sevilla::parse_double("nan", value));
+        REQUIRE(std::isnan(value));
+    }
+
+    SECTION("parses booleans") {
+        bool value = false;
+
+        REQUIRE(sevilla::parse_bool("TRUE", value));
+        REQUIRE(value);
+        REQUIRE(sevilla::parse_bool("no", value));
+        REQUIRE_FALSE(value);
+        REQUIRE(sevilla::parse_bool("1", value));
+        REQUIRE(value);
+        REQUIRE_FALSE(sevilla::parse_bool("maybe", value));
+    }
+
+    SECTION("parses timestamps") {
+        int64_t value = 0;
+
+        REQUIRE(sevilla::parse_timestamp("1970-01-02", value));
+        REQUIRE(value == 86400000000LL);
+        REQUIRE(sevilla::parse_timestamp("2000-02-29T12:30:15.5Z", value));
+        REQUIRE(value == 951827415500000LL);
+        REQUIRE(sevilla::parse_timestamp("2000-02-29 07:30:15.5-05:00", value));
+        REQUIRE(value == 951827415500000LL);
+        REQUIRE(sevilla::parse_timestamp("1969-12-31T23:59:59", value));
+        REQUIRE(value == -1000000LL);
+        REQUIRE_FALSE(sevilla::parse_timestamp("2001-02-29", value));
+        REQUIRE_FALSE(sevilla::parse_timestamp("2000-01-01T24:00", value));
+        REQUIRE(sevilla::parse_timestamp("2000-02-29T12:30:15.5+0000", value));
+        REQUIRE(value == 951827415500000LL);
+        REQUIRE(sevilla::parse_timestamp("2000-02-29T17:30:15.5+05", value));
+        REQUIRE(value == 951827415500000LL);
+        REQUIRE_FALSE(sevilla::parse_timestamp("2000-01-01x", value));
+        REQUIRE_FALSE(sevilla::parse_timestamp("2000-01-01T12:00+05:", value));
+        REQUIRE_FALSE(sevilla::parse_timestamp("2000-01-01T12:00+05:3", value));
+        REQUIRE_FALSE(sevilla::parse_timestamp("2000-01-01T12:00+053", value));
+    }
+}
@@ -0,0 +1,66 @@
+//
+// Created by Andres Jaimes on 26/07/25.
+//
+
+#include <dlfcn.h>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+
+#if defined(_WIN32)
+    #define LIBNAME "sevilla.dll"
+#elif defined(__APPLE__)
+    #define LIBNAME "libsevilla.dylib"
+#else
+    #define LIBNAME "libsevilla.so"
+#endif
+
+struct CsvWriterLoaderFixture {
+
+    typedef const char* (*write_func)(const char* const*, const size_t*, size_t, size_t, char, size_t*);
+    write_func write_csv_rows;
+    void* handle = nullptr;
+
+    // load the dynamic library
+    CsvWriterLoaderFixture() {
+        handle = dlopen(LIBNAME, RTLD_NOW);
+        if (handle != nullptr) {
+            write_csv_rows = reinterpret_cast<write_func>(dlsym(handle, "sv_write_csv_rows"));
+        }
+    }
+
+    // unload the dynamic library
+    ~CsvWriterLoaderFixture() {
+        if (handle != nullptr) {
+            dlclose(handle);
+        }
+    }
+};
+
+TEST_CASE_METHOD(CsvWriterLoaderFixture, "csv writer c-api", "[csv][shared]") {
+
+    REQUIRE(handle != nullptr);
+
+    SECTION("writes many rows per call") {
+        const char* fields[] = {"a", "b,c", nullptr, "d\"e"};
+        size_t length = 0;
+        const char* text = write_csv_rows(fields, nullptr, 2, 2, ',', &length);
+
+        REQUIRE(std::string(text, length) == "a,\"b,c\"\n,\"d\"\"e\"\n");
+    }
+
+    SECTION("uses the given field lengths") {
+        const char* fields[] = {"abc", "x;y"};
+        const size_t lengths[] = {2, 3};
+        size_t length = 0;
+        const char* text = write_csv_rows(fields, lengths, 1, 2, ';', &length);
+
+        REQUIRE(std::string(text, length) == "ab;\"x;y\"\n");
+    }
+
+    SECTION("correctly handles a null value") {
+        size_t length = 1;
+        REQUIRE(write_csv_rows(nullptr, nullptr, 1, 1, ',', &length) == nullptr);
+        REQUIRE(length == 0);
+    }
+
+}
@@ -0,0 +1,86 @@
+//
+// Created by Andres Jaimes on 26/07/25.
+//
+
+#include <cstdio>
+#include <random>
+#include <catch2/catch_test_macros.hpp>
+#include "../src/csv_reader.h"
+#include "../src/csv_writer.h"
+
+TEST_CASE("csv writer", "[csv][writer]") {
+
+    sevilla::csv_writer writer;
+
+    SECTION("csv writer only quotes fields that need it") {
+        writer.write_row({"plain", "with,comma", "with \"quote\"", "two\nlines", "cr\r", ""});
+
+        REQUIRE(writer.data() == "plain,\"with,comma\",\"with \"\"quote\"\"\",\"two\nlines\",\"cr\r\",\n");
+        REQUIRE(writer.rows() == 1);
+    }
+
+    SECTION("csv writer uses the given separator and line break") {
+        sevilla::csv_writer tabs('\t');
+        tabs.set_line_break("\r\n");
+        tabs.write_row({"a,b", "c\td"});
+
+        REQUIRE(tabs.data() == "a,b\t\"c\td\"\r\n");
+    }
+
+    SECTION("csv writer round trips through the reader") {
+        std::mt19937 random(11);
+        std::uniform_int_distribution<int> length(0, 80);
+        std::uniform_int_distribution<size_t> pick(0, 7);
+        static const char alphabet[] = "ab,\"\n\r x";
+
+        std::vector<std::vector<std::string>> rows(200);
+        for (auto& row : rows) {
+            row.resize(5);
+            for (std::string& field : row) {
+                field.resize(length(random));
+                for (char& c : field) {
+                    c = alphabet[pick(random)];
+                }
+            }
+            writer.write_row(std::vector<std::string_view>(row.begin(), row.end()));
+        }
+
+        sevilla::csv_reader reader;
+        reader.open(writer.data().data(), writer.data().size(), ',');
+        for (const auto& row : rows) {
+            REQUIRE(reader.next());
+            REQUIRE(reader.size() == row.size());
+            for (size_t c = 0; c < row.size(); c++) {
+                REQUIRE(reader.view(c) == row[c]);
+            }
+        }
+        REQUIRE_FALSE(reader.next());
+    }
+
+    SECTION("csv writer copies parsed records") {
+        sevilla::csv_parser parser;
+        parser.parse_line(R"(a,"b""c",d)", ',');
+        writer.write_row(parser);
+
+        REQUIRE(writer.data() == "a,\"b\"\"c\",d\n");
+    }
+
+    SECTION("csv writer flushes to a file descriptor") {
+        std::FILE* file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        {
+            sevilla::csv_writer output(fileno(file), ',', 16);
+            output.write_row({"first", "row"});
+            output.write_row({"second", "row"});
+            REQUIRE(output.data().empty());
+            output.write_row({"x"});
+            REQUIRE(output.data() == "x\n");
+        }
+
+        std::rewind(file);
+        char contents[64] = {};
+        const size_t size = std::fread(contents, 1, sizeof(contents), file);
+        std::fclose(file);
+        REQUIRE(std::string(contents, size) == "first,row\nsecond,row\nx\n");
+    }
+}
@@ -4,6 +4,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <httplib.h>
+#include "../src/csv_stream_parser.h"
 #include "../src/http_client.h"
 
 TEST_CASE("encoding functions", "[http_client][encoding]") {
@@ -135,6 +136,15 @@ void run_http_server() {
         res.set_content("Sent: " + body + " using: " + content_type, "text/plain");
     });
 
+    svr.Get("/csv", [](const httplib::Request &req, httplib::Response &res) {
+        std::string body = "id,note\n";
+        for (int i = 0; i < 20000; i++) {
+            body += std::to_string(i) + (i % 2 == 0 ? ",\"two\nlines, quoted\"\n" : ",plain\n");
+        }
+        res.status = 200;
+        res.set_content(body, "text/csv");
+    });
+
     // Special endpoint to stop the server
     svr.Get("/stop", [&](const httplib::Request& req, httplib::Response& res) {
         res.set_content("Server stopping...", "text/plain");
@@ -242,6 +252,36 @@ TEST_CASE_METHOD(WebServerFixture, "make_request function", "[http_client][make_
         REQUIRE(http_client.response_body == "Authorization: Bearer token");
     }
 
+    SECTION("stream a csv response body through on_data") {
+        size_t records = 0;
+        size_t pieces = 0;
+        bool ordered = true;
+        sevilla::csv_stream_parser parser(',', [&](const sevilla::csv_parser& record) {
+            if (records > 0) {
+                const std::string note = records % 2 == 1 ? "two\nlines, quoted" : "plain";
+                ordered = ordered && record.size() == 2 && record.view(0) == std::to_string(records - 1)
+                          && record.view(1) == note;
+            }
+            records++;
+        });
+
+        http_client.url = "http://127.0.0.1:16435/csv";
+        http_client.on_data = [&](const char* data, const size_t size) {
+            pieces++;
+            parser.feed(data, size);
+        };
+        http_client.make_request();
+        parser.finish();
+
+        REQUIRE(http_client.error == CURLE_OK);
+        REQUIRE(http_client.status_code == 200);
+        REQUIRE(http_client.response_body.empty());
+        REQUIRE(pieces > 1);
+        REQUIRE(records == 20001);
+        REQUIRE(ordered);
+        REQUIRE(parser.pending_size() == 0);
+    }
+
     SECTION("handle a timeout because of a slow server response") {
         http_client.url = "http://127.0.0.1:16435/slow-response";
         http_client.max_timeout = 100; // 100 milliseconds
@@ -60,3 +60,47 @@ TEST_CASE("trim operations", "[utils][trim]") {
     }
 
 }
+
+TEST_CASE("utf transcoding", "[utils][utf]") {
+
+    SECTION("round-trips ascii, accents and characters outside the bmp") {
+        const std::string text = "plain ascii text, caf\xC3\xA9, \xE2\x82\xAC 5, \xF0\x9F\x98\x80!";
+        std::wstring wide;
+        sevilla::utf8_to_wide(text, wide);
+
+        REQUIRE(wide.substr(0, 5) == L"plain");
+        REQUIRE(wide.size() == (sizeof(wchar_t) == 2 ? 32 : 31));
+
+        std::string back;
+        sevilla::wide_to_utf8(wide, back);
+        REQUIRE(back == text);
+    }
+
+    SECTION("appends to the output") {
+        std::wstring wide = L"a";
+        sevilla::utf8_to_wide("bc", wide);
+        REQUIRE(wide == L"abc");
+
+        std::string narrow = "x";
+        sevilla::wide_to_utf8(L"yz", narrow);
+        REQUIRE(narrow == "xyz");
+    }
+
+    SECTION("accepts surrogate pairs in wide strings") {
+        std::string narrow;
+        sevilla::wide_to_utf8(std::wstring{static_cast<wchar_t>(0xD83D), static_cast<wchar_t>(0xDE00)}, narrow);
+        REQUIRE(narrow == "\xF0\x9F\x98\x80");
+    }
+
+    SECTION("rejects malformed data") {
+        std::wstring wide;
+        for (const std::string bad : {"\x80", "caf\xC3", "\xC0\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "ab\xFF"}) {
+            REQUIRE_THROWS_AS(sevilla::utf8_to_wide(bad, wide), std::invalid_argument);
+        }
+
+        std::string narrow;
+        REQUIRE_THROWS_AS(sevilla::wide_to_utf8(std::wstring(1, static_cast<wchar_t>(0xDC00)), narrow), std::invalid_argument);
+        REQUIRE_THROWS_AS(sevilla::wide_to_utf8(std::wstring{static_cast<wchar_t>(0xD800), L'a'}, narrow), std::invalid_argument);
+    }
+
+}